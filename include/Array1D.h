@@ -136,6 +136,13 @@ public:
 
 
 
+  V const* get_dataptr() const
+  {
+    return data;
+  }
+
+
+
   /** Zugriffs-Operator
    *  Gibt den Inhalt eines Vektors fuer einen gegebenen Index zurueck.
    *  Es wird geprueft, ob die Laenge des Vektors eingehalten wird.
@@ -342,42 +349,21 @@ public:
       //=========================================
 
 
-      // alten Inhalt abspeichern
-      V* old_data = (V*) new V[size];
-      for(int r=0; r<size; r++)
-        old_data[r] = data[r];
+      // neuen Inhalt anlegen
+      V* new_data = (V*) new V[s];
 
 
-      // alten Inhalt loeschen
-      delete[] data;
-      data      = 0;
+      // alter Inhalt wird fuer die alte Laenge uebernommen,
+      // neue Eintraege werden initialisiert
+      for(int r=0; r<s; r++)
+        new_data[r] = (r < size) ? data[r] : 0;
 
-      // neuen Inhalt anlegen
-      data        = (V*) new V[s];
-
-
-      // alten Inhalt wiederherstellen
-      if (size > s)
-      {
-        // Vektor wird kleiner, Inhalt wird fuer neue Laenge kopiert
-        for(int r=0; r<s; r++)
-          data[r] = old_data[r];
-      }
-      else
-      {
-        // Vektor wird groesser, Inhalt wird fuer alte Laenge kopiert
-        for(int r=0; r<size; r++)
-          data[r] = old_data[r];
-        // neue Eintraege werden initialisiert
-        for(int r=size; r<s; r++)
-          data[r] = 0;
-      }
-
-
-      // neue Laenge wird gesetzt
+
+      // alten Inhalt loeschen, neue Laenge wird gesetzt
+      delete[] data;
+      data        = new_data;
       size        = s;
 
-      delete[] old_data;
       return;
     }
 
@@ -485,6 +485,37 @@ public:
 
 
 
+  /** Auswahl von Spalten ohne neue Allokation
+   *  Es bleiben nur die angegebenen Spalten in dieser Reihenfolge erhalten,
+   *  die Spaltennummern muessen aufsteigend sortiert sein.
+   *
+   */
+  void keep_columns(
+      int const*                  cols,               ///< Nummern der verbleibenden Spalten (i)
+      int                         num                 ///< Anzahl verbleibender Spalten (i)
+      )
+  {
+    if (num == 0)
+    {
+      delete [] data;
+      data   = NULL;
+      size_2 = 0;
+      return;
+    }
+
+    // die Zielposition liegt nie hinter der Quellposition
+    for(int r=0; r<size_1; r++)
+      for(int c=0; c<num; c++)
+        data[r*num + c] = data[r*size_2 + cols[c]];
+
+    size_2 = num;
+
+    return;
+  }
+
+
+
+
   /** Rueckgabe der Anzahl der Zeilen der Matrix
    *
    */
@@ -0,0 +1,198 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#ifndef AUTOTUNER_H_
+#define AUTOTUNER_H_
+
+
+/** Speicherformat der globalen Steifigkeitsmatrix
+ *
+ */
+enum Matrix_Format
+{
+  FORMAT_MSR,
+  FORMAT_DENSE
+};
+
+
+
+/** Loeser, zwischen denen der Autotuner waehlt
+ *
+ */
+enum Solver_Kind
+{
+  KIND_CHOLESKY,
+  KIND_LU,
+  KIND_GS,
+  KIND_CG
+};
+
+
+
+/** Vorkonditionierer fuer KIND_CG
+ *
+ */
+enum Precond_Kind
+{
+  PRECOND_NONE,                                       // kein Vorkonditionierer (direkte Loeser, GS)
+  PRECOND_JACOBI,
+  PRECOND_SSOR,
+  PRECOND_IC,
+  PRECOND_AMG,
+  PRECOND_GMG
+};
+
+
+
+/** Kombination aus Matrixformat, Loeser und Vorkonditionierer
+ *
+ */
+struct Autotune_Choice
+{
+  Matrix_Format                   format;
+  Solver_Kind                     solver;
+  Precond_Kind                    precond;
+};
+
+
+
+/** Kenngroessen der Steifigkeitsmatrix, aus denen die Signatur gebildet wird
+ *
+ */
+struct Matrix_Properties
+{
+  int                             num_eq;             // Anzahl Gleichungen
+  int                             nnz;                // Anzahl Nicht-Null-Eintraege
+  int                             bandwidth;          // max |i-j| ueber alle Eintraege
+  bool                            symmetric;          // a_ij == a_ji (bis auf Rundung)
+  unsigned int                    pattern_hash;       // FNV-1a-Hash der Besetzungsstruktur
+};
+
+
+
+/** Automatische Wahl von Matrixformat, Loeser und Vorkonditionierer
+ *  Ausgangspunkt ist die assemblierte Matrix_MSR. Aus Groesse, nnz/Zeile,
+ *  Bandbreite und Symmetrie wird eine Signatur gebildet; ist sie in der
+ *  Cache-Datei eingetragen, wird die dort gespeicherte Wahl verwendet.
+ *  Sonst waehlt eine Heuristik, oder es laufen zeitlich begrenzte Probeloesungen
+ *  aller passenden Kombinationen mit der echten rechten Seite: jede Probe
+ *  wird abgebrochen, sobald sie laenger dauert als die bisher schnellste
+ *  (die erste nach trial_limit Sekunden). Da factorize selbst nicht
+ *  unterbrochen werden kann, entfallen Kombinationen, deren Aufbau
+ *  absehbar zu teuer ist oder fehlschlaegt.
+ *  Die gewaehlte Kombination wird in die Cache-Datei geschrieben.
+ *
+ */
+class Autotuner
+{
+
+
+protected:
+  Discretization                 *dis;                // Diskretisierung (fuer Matrix_Dense, AMG, GMG)
+  bool                            trials;             // Probeloesungen statt Heuristik
+  string                          cache_file;         // Cache-Datei, leer fuer keinen Cache
+  double                          tol_ite;            // Abbruchschranke der iterativen Loeser
+  int                             max_ite;            // maximale Anzahl Iterationen
+  int                             dense_limit;        // groesste Anzahl Gleichungen fuer Matrix_Dense
+  double                          dense_rate;         // angenommene Rechenleistung der dichten Zerlegung [Flop/s]
+  double                          trial_limit;        // Zeitschranke der ersten Probeloesung [s]
+  Matrix_Properties               props;              // Kenngroessen der zuletzt analysierten Matrix
+
+
+  bool read_cache(Autotune_Choice& _choice) const;
+  void write_cache(Autotune_Choice const& _choice) const;
+
+  void candidates(Array1D<Autotune_Choice>& _list, int& _num) const;
+  bool feasible(Autotune_Choice const& _choice, double _budget) const;
+  double trial(Autotune_Choice const& _choice, Matrix_MSR& _a, Array1D<double>& _f, double _budget) const;
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Autotuner (
+      Discretization*             _dis,                // Diskretisierung (i)
+      bool                        _trials = true,      // Probeloesungen durchfuehren (i)
+      char const*                 _cache  = "numpro_autotune.cache", // Cache-Datei, NULL fuer keinen Cache (i)
+      double                      _tol    = 1e-8,      // Abbruchschranke der iterativen Loeser (i)
+      int                         _max    = 10000      // maximale Anzahl Iterationen (i)
+      )
+  {
+    dis         = _dis;
+    trials      = _trials;
+    cache_file  = (_cache != NULL) ? _cache : "";
+    tol_ite     = _tol;
+    max_ite     = _max;
+    dense_limit = 3000;
+    dense_rate  = 1e9;
+    trial_limit = 60.0;
+  }
+
+
+  void analyze(Matrix const& _a);
+  string signature() const;
+  Autotune_Choice heuristic() const;
+  Autotune_Choice tune(Matrix& _a, Array1D<double>& _f);
+
+  Solver* create_solver(Autotune_Choice const& _choice, Preconditioner*& _precond) const;
+  void select(Matrix*& _a, Solver*& _solver, Preconditioner*& _precond, Array1D<double>& _f);
+
+  static string to_string(Autotune_Choice const& _choice);
+  static bool from_string(string const& _str, Autotune_Choice& _choice);
+
+
+  Matrix_Properties const& get_properties() const
+  {
+    return props;
+  }
+
+
+  void set_dense_limit(int _n)
+  {
+    dense_limit = _n;
+  }
+
+
+  void set_trial_limit(double _t)
+  {
+    trial_limit = _t;
+  }
+
+
+};
+
+
+#endif /* AUTOTUNER_H_ */
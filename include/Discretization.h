@@ -39,6 +39,7 @@ mvs@ibb.uni-stuttgart.de
 
 #include "Node.h"
 #include "Element.h"
+#include "Renumbering.h"
 class Material;
 
 
@@ -61,23 +62,53 @@ protected:
   int                        num_dof_solve;      // Anzahl der zu loesenden Freiheitsgrade (Groesse des globale LGS)
   int                        num_dof_dirich;     // Anzahl der durch Dirichlet-RB festgehaltenen Freiheitsgrade
 
+  double                     l_x, l_y;           // Laenge des Gebiets in x- und y-Richtung
+  int                        div_x, div_y;       // Anzahl Elemente in x- und y-Richtung
+  bool                       verbose;            // Ausgabe auf den Bildschirm
+  Renumber_Type              renumber;           // Nummerierung der Knoten vor der Vergabe der Freiheitsgrade
+
+  int                        num_colors;         // Anzahl Farben der Elemente
+  Array1D<int>               color_ptr;          // Anfang jeder Farbe in color_ele
+  Array1D<int>               color_ele;          // Elemente nach Farben sortiert
+
+  Array1D<int>               scatter_map;        // Position von ele_stiff[l][k] im Wertevektor, -1: gehalten
+  Matrix_MSR const*          scatter_matrix;     // Matrix, fuer die scatter_map erstellt wurde
+  int                        scatter_nnz;        // deren Anzahl Nicht-Null-Eintraege
+
+  Element_Cache              ele_cache;          // gemeinsame Elementsteifigkeitsmatrizen
+
 
 
 public:
 
-  Discretization();
+  Discretization(double _l_x = 10, double _l_y = 1, int _div_x = 10, int _div_y = 4, bool _verbose = true,
+      Renumber_Type _renumber = RENUMBER_NONE);
+
+  ~Discretization();
 
   void assign_dofs();
 
+  void color_elements();
+
+  void build_element_cache();
+
+  void node_graph(Array1D<int>& _ptr, Array1D<int>& _adj);
+
+  void dof_envelope(int& _bandwidth, long& _profile);
+
+  void build_scatter_map(Matrix_MSR const* _a);
+
   void assemble_stalin(Matrix *_a);
 
+  Matrix_MSR* assemble_stalin_triplets();
+
   void assemble_fext(Array1D<double> &_fext);
 
   void cal_stress_lin();
 
   void disp2node_copy(Array1D<double>& _disp);
 
-  void fill_dof_connect(int&  _nnz, Array1D<int>& _num_dof_connect, Array1D< List<int> >& _dof_connect, bool _msr);
+  void fill_dof_connect(int& _nnz, Array1D<int>& _row_ptr, Array1D<int>& _col, bool _msr);
 
 
 
@@ -160,6 +191,40 @@ public:
 
 
 
+  /** Rueckgabe der Anzahl der Knoten
+   *
+   */
+  int node_get_size()
+  {
+    return node.get_size();
+  }
+
+
+
+
+  /** Rueckgabe der Abmessungen und der Unterteilung des Gebiets
+   *  Knoten (j,i) hat die Nummer j + (div_x+1)*i.
+   *
+   */
+  double get_l_x()   { return l_x; }
+  double get_l_y()   { return l_y; }
+  int    get_div_x() { return div_x; }
+  int    get_div_y() { return div_y; }
+
+
+
+
+  /** Rueckgabe der Strategie fuer die Nummerierung der Freiheitsgrade
+   *
+   */
+  Renumber_Type get_renumber()
+  {
+    return renumber;
+  }
+
+
+
+
   /** Rueckgabe der Anzahl der zu loesenden Freiheitsgrade
    *
    *  */
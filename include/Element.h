@@ -146,6 +146,17 @@ public:
 
 
 
+  /** Zeiger auf das Material abfragen
+   *
+   */
+  Material* get_material()
+  {
+    return material;
+  }
+
+
+
+
   /** einen Knoten-Zeiger aus der Liste abfragen
    *
    */
@@ -161,6 +172,7 @@ public:
 
 
 #include "Scheibe_q1.h"
+#include "Element_Cache.h"
 
 
 #endif /* ELEMENT_H_ */
@@ -0,0 +1,127 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef ELEMENT_CACHE_H_
+#define ELEMENT_CACHE_H_
+
+
+/** Zwischenspeicher fuer Elementsteifigkeitsmatrizen
+ * Elemente mit gleicher Geometrie (Knotenkoordinaten relativ zum ersten
+ * Knoten) und gleichen Materialparametern teilen sich eine gespeicherte
+ * Matrix. Die Signatur rundet die relativen Koordinaten auf ein Raster der
+ * Weite tol, die Materialparameter gehen bitweise ein. Gespeichert wird die
+ * Matrix des ersten Elements jeder Klasse, zeilenweise (l*8+k).
+ * Nach einer Aenderung von Knotenkoordinaten oder Materialien muss der
+ * Speicher mit build() neu aufgebaut werden.
+ *
+ */
+class Element_Cache
+{
+
+
+protected:
+  static const int                key_len = 8;        // Laenge der Signatur
+  static const int                mat_len = 64;       // Eintraege einer Elementmatrix
+
+  int                             num_entries;        // Anzahl verschiedener Matrizen
+  Array1D<long long>              keys;               // Signaturen, key_len pro Matrix
+  Array1D<double>                 matrices;           // Matrizen, mat_len pro Matrix
+  Array1D<int>                    table;              // Hash-Tabelle (offene Adressierung), -1: frei
+  Array1D<int>                    ele_entry;          // Matrix fuer jedes Element
+
+
+  void signature(Element& _ele, double _tol, long long* _key);
+
+
+public:
+
+
+  /** Konstruktor fuer einen leeren Speicher
+   *
+   */
+  Element_Cache()
+  {
+    num_entries = 0;
+  }
+
+
+
+
+  /** Destruktor
+   *
+   */
+  ~Element_Cache() { }
+
+
+
+  void build(List<Element*>& _element, double _tol);
+
+
+
+
+  /** Elementsteifigkeitsmatrix eines Elements (8x8, zeilenweise)
+   *
+   */
+  double const* get_stiffness(
+      int                         _e                  // Elementnummer (i)
+      ) const
+  {
+    return matrices.get_dataptr() + mat_len*ele_entry.get_dataptr()[_e];
+  }
+
+
+
+
+  /** Rueckgabe der Anzahl verschiedener Matrizen
+   *
+   */
+  int get_num_entries() const
+  {
+    return num_entries;
+  }
+
+
+
+
+  /** Wurde der Speicher aufgebaut?
+   *
+   */
+  bool is_built() const
+  {
+    return ele_entry.get_size() > 0;
+  }
+
+};
+
+
+#endif /* ELEMENT_CACHE_H_ */
@@ -63,6 +63,28 @@ public:
 
 
 
+  /** Rueckgabe des E-Moduls
+   *
+   */
+  double get_e() const
+  {
+    return e;
+  }
+
+
+
+
+  /** Rueckgabe der Querdehnzahl
+   *
+   */
+  double get_nu() const
+  {
+    return nu;
+  }
+
+
+
+
   /** Funktion zum Berechnen der linearen Materialmatrix in 2D
    *
    */
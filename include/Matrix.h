@@ -66,13 +66,15 @@ public:
   virtual void init() = 0;
   virtual void print() = 0;
   virtual void print_mask() = 0;
-  virtual int  get_size() = 0;
+  virtual int  get_size() const = 0;
 
-  virtual double get_entry(int n, int m) = 0;
+  virtual double get_entry(int n, int m) const = 0;
   virtual void   add_entry(int n, int m, double val) = 0;
 
 
   virtual Array1D<double> operator*   (const Array1D<double> &v) const = 0;
+  virtual void            mult        (const Array1D<double> &v, Array1D<double> &result) const = 0;
+  virtual void            mult        (const Array2D<double> &v, Array2D<double> &result) const = 0;
   virtual Array1D<double> vorwaerts   (const Array1D<double> &v) = 0;
   virtual Array1D<double> rueckwaerts (const Array1D<double> &v) = 0;
 
@@ -157,6 +159,7 @@ public:
 
 #include "Matrix_Dense.h"
 #include "Matrix_MSR.h"
+#include "Triplet_List.h"
 
 
 #endif /* MATRIX_H_ */
@@ -101,10 +101,10 @@ public:
   void init();
   void print();
   void print_mask();
-  int get_size();
+  int get_size() const;
 
   void add_entry(int n, int m, double val);
-  double get_entry(int n, int m);
+  double get_entry(int n, int m) const;
 
 
 
@@ -126,15 +126,67 @@ public:
     }
 
     Array1D<double> result( v.get_size() );
-    result.init();
+    mult(v, result);
+
+    return result;
+  }
+
+
 
-    for (unsigned int i = 0; i < num_eq; i++) {
-      for (unsigned int j = 0; j < num_eq; j++) {
-        result[i] += value[i][j] * v[j];
+
+  /** Matrix-Vektor-Produkt ohne Allokation: result = A * v
+   *
+   */
+  void mult (
+      Array1D<double> const&      v,                  ///< Vektor, mit dem multipliziert werden soll (i)
+      Array1D<double>&            result              ///< Ergebnis, muss bereits allokiert sein (o)
+      ) const
+  {
+    double const* vp = v.get_dataptr();
+    double*       rp = result.get_dataptr();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_eq; i++) {
+      double const* a_i = value[i];
+      double sum = 0.0;
+      for (int j = 0; j < num_eq; j++)
+        sum += a_i[j] * vp[j];
+      rp[i] = sum;
+    }
+
+    return;
+  }
+
+
+
+
+  /** Matrix-Block-Produkt ohne Allokation: result = A * v
+   *  v und result haben num_eq Zeilen und eine Spalte pro Vektor,
+   *  jede Zeile der Matrix wird nur einmal gelesen.
+   *
+   */
+  void mult (
+      Array2D<double> const&      v,                  ///< Vektoren, mit denen multipliziert werden soll (i)
+      Array2D<double>&            result              ///< Ergebnis, muss bereits allokiert sein (o)
+      ) const
+  {
+    int s = v.get_size_2();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_eq; i++) {
+      double const* a_i = value[i];
+      double*       r_i = result[i];
+      for (int c = 0; c < s; c++)
+        r_i[c] = 0.0;
+      for (int j = 0; j < num_eq; j++) {
+        double        a_ij = a_i[j];
+        double const* v_j  = v[j];
+        for (int c = 0; c < s; c++)
+          r_i[c] += a_ij * v_j[c];
       }
     }
 
-    return result;
+    return;
   }
 
 
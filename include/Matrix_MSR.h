@@ -68,6 +68,8 @@ public:
 
   Matrix_MSR( Discretization *dis);
 
+  Matrix_MSR( int _num_eq, int const* _ptr, int const* _col, double const* _val);
+
 
 
 
@@ -87,14 +89,62 @@ public:
   void init();
   void print();
   void print_mask();
-  int  get_size();
+  int  get_size() const;
+  int  color_rows(Array1D<int>& color_ptr, Array1D<int>& rows) const;
 
-  double get_entry(int n, int m);
+  double get_entry(int n, int m) const;
+  int    get_offset(int n, int m) const;
   void   add_entry(int n, int m, double val);
 
 
 
 
+  /** Rueckgabe der Anzahl der Nicht-Null-Eintraege (Laenge von value ohne 1)
+   *
+   */
+  int get_nnz() const
+  {
+    return nnz;
+  }
+
+
+
+
+  /** direkter Lesezugriff auf den Vektor der Werte (MSR: erst die Diagonale)
+   *
+   */
+  double const* get_value() const
+  {
+    return value.get_dataptr();
+  }
+
+
+
+
+  /** direkter Schreibzugriff auf den Vektor der Werte, z.B. fuer die
+   *  Assemblierung ueber vorab bestimmte Positionen (get_offset)
+   *
+   */
+  double* get_value()
+  {
+    return value.get_dataptr();
+  }
+
+
+
+
+  /** direkter Lesezugriff auf den Vektor der Indizes
+   *  index[0..num_eq] sind Zeilenanfaenge, danach folgen die Spaltennummern
+   *
+   */
+  int const* get_index() const
+  {
+    return index.get_dataptr();
+  }
+
+
+
+
   /** Matrix-Vektor-Produkt
    * Homework 3
    */
@@ -112,15 +162,7 @@ public:
     }
 
     Array1D<double> result( _v.get_size() );
-    result.init();
-
-    for (unsigned int i = 0; i < _v.get_size(); i++) {
-      result[i] += value[i] * _v[i];
-        for (unsigned int j = index[i]; j < index[i+1]; j++) {
-          double column = index[j];
-          result[i] += value[j] * _v[column];
-        }
-    }
+    mult(_v, result);
 
     return result;
   };
@@ -128,6 +170,66 @@ public:
 
 
 
+  /** Matrix-Vektor-Produkt ohne Allokation: result = A * v
+   *
+   */
+  void mult (
+      const Array1D<double> &     _v,                  // Vektor, mit dem multipliziert werden soll (i)
+      Array1D<double> &           _result              // Ergebnis, muss bereits allokiert sein (o)
+      ) const
+  {
+    double const* val = value.get_dataptr();
+    int    const* idx = index.get_dataptr();
+    double const* vp  = _v.get_dataptr();
+    double*       rp  = _result.get_dataptr();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_eq; i++) {
+      double sum = val[i] * vp[i];
+      for (int j = idx[i]; j < idx[i+1]; j++)
+        sum += val[j] * vp[idx[j]];
+      rp[i] = sum;
+    }
+
+    return;
+  }
+
+
+
+
+  /** Matrix-Block-Produkt ohne Allokation: result = A * v
+   *  v und result haben num_eq Zeilen und eine Spalte pro Vektor,
+   *  jeder Eintrag der Matrix wird nur einmal gelesen.
+   *
+   */
+  void mult (
+      const Array2D<double> &     _v,                  // Vektoren, mit denen multipliziert werden soll (i)
+      Array2D<double> &           _result              // Ergebnis, muss bereits allokiert sein (o)
+      ) const
+  {
+    double const* val = value.get_dataptr();
+    int    const* idx = index.get_dataptr();
+    int           s   = _v.get_size_2();
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < num_eq; i++) {
+      double*       r_i = _result[i];
+      double const* v_i = _v[i];
+      for (int c = 0; c < s; c++)
+        r_i[c] = val[i] * v_i[c];
+      for (int j = idx[i]; j < idx[i+1]; j++) {
+        double const* v_j = _v[ idx[j] ];
+        for (int c = 0; c < s; c++)
+          r_i[c] += val[j] * v_j[c];
+      }
+    }
+
+    return;
+  }
+
+
+
+
   /** Vorwaertseinsetzen
    *
    */
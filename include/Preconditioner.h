@@ -0,0 +1,70 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_H_
+#define PRECONDITIONER_H_
+
+
+
+/** abstrakte Klasse zur Beschreibung eines Vorkonditionierers
+ *  - setup: einmalige Vorbereitung fuer eine Matrix (Diagonale, Zerlegung, ...)
+ *  - apply: out = C * in, ohne Allokation, beliebig oft fuer dieselbe Matrix
+ *
+ */
+class Preconditioner
+{
+
+
+public:
+
+  virtual ~Preconditioner() {};
+
+
+  virtual void setup(Matrix const& a) = 0;
+  virtual void apply(Array1D<double> const& in, Array1D<double>& out) const = 0;
+
+
+};
+
+
+#include "Preconditioner_Jacobi.h"
+#include "Preconditioner_SSOR.h"
+#include "Preconditioner_BlockJacobi.h"
+#include "Preconditioner_IC.h"
+#include "Preconditioner_Multigrid.h"
+#include "Preconditioner_AMG.h"
+#include "Preconditioner_GMG.h"
+#include "Preconditioner_Chebyshev.h"
+#include "Preconditioner_Schwarz.h"
+
+
+#endif /* PRECONDITIONER_H_ */
@@ -0,0 +1,80 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_AMG_H_
+#define PRECONDITIONER_AMG_H_
+
+
+/** Algebraisches Mehrgitterverfahren mit geglaetteter Aggregation (SA-AMG)
+ *  als Vorkonditionierer fuer Solver_CG.
+ *  - Nahkern: Starrkoerperbewegungen der Scheibe (zwei Verschiebungen, eine
+ *    Rotation), aus den Knotenkoordinaten der Diskretisierung
+ *  - Aggregation auf Knotenebene ueber den Graphen der starken Kopplungen
+ *  - Prolongation P = (I - omega*D^-1*A) * Pt, Restriktion R = P^T,
+ *    Grobgittermatrix A_c = R*A*P (Galerkin)
+ *  Die Hierarchie wird nur fuer Matrizen im MSR-Format aufgebaut.
+ *
+ */
+class Preconditioner_AMG : public Preconditioner_Multigrid
+{
+
+
+protected:
+  Discretization*                 dis;                // Diskretisierung fuer Knoten und Koordinaten
+  double                          theta;              // Schranke fuer starke Kopplungen
+
+
+  static int  aggregate(Matrix_MSR const& _a, Array1D<int> const& _node, int _num_nodes,
+                        double _theta, Array1D<int>& _agg);
+  static int  tentative(Array1D<int> const& _node, Array1D<int> const& _agg, int _num_agg,
+                        Array2D<double> const& _b, CSR& _pt, Array2D<double>& _b_c,
+                        Array1D<int>& _node_c);
+
+
+public:
+
+  Preconditioner_AMG(
+      Discretization*             _dis,                // Zeiger auf die Diskretisierung (i)
+      Smoother_Type               _type = SMOOTHER_CHEBYSHEV, // Typ der Glaetter (i)
+      int                         _coarse_size = 200,  // Groesse des Grobgitters (i)
+      int                         _max_levels = 10,    // maximale Anzahl Level (i)
+      double                      _theta = 0.08        // Schranke fuer starke Kopplungen (i)
+      );
+
+
+  void setup(Matrix const& _a);
+
+
+};
+
+
+#endif /* PRECONDITIONER_AMG_H_ */
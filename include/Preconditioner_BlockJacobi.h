@@ -0,0 +1,64 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_BLOCKJACOBI_H_
+#define PRECONDITIONER_BLOCKJACOBI_H_
+
+
+/** Knoten-Block-Jacobi-Vorkonditionierer
+ *  Die (hoechstens) 2x2 Bloecke der Freiheitsgrade eines Knotens werden
+ *  in setup invertiert. Ist ein Freiheitsgrad des Knotens festgehalten,
+ *  besteht der Block nur aus einem Eintrag.
+ *
+ */
+class Preconditioner_BlockJacobi : public Preconditioner
+{
+
+
+protected:
+  int                             num_blocks;         // Anzahl Knoten-Bloecke
+  Array1D<int>                    block_dof;          // je Block zwei Freiheitsgrade, -1 wenn festgehalten
+  Array1D<double>                 block_inv;          // je Block die Inverse (2x2, zeilenweise)
+
+
+public:
+
+  Preconditioner_BlockJacobi(Discretization *_dis);
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_BLOCKJACOBI_H_ */
@@ -0,0 +1,90 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef PRECONDITIONER_CHEBYSHEV_H_
+#define PRECONDITIONER_CHEBYSHEV_H_
+
+
+/** Polynom-Vorkonditionierer: feste Anzahl Chebyshev-Schritte fuer a*z=r
+ *  mit Startwert Null und einem inneren Vorkonditionierer (Standard Jacobi).
+ *  Das Polynom haengt nur vom Eigenwertintervall ab, apply braucht daher
+ *  keine Skalarprodukte und ist linear und symmetrisch (fuer Solver_CG).
+ *  Das Intervall wird in setup mit einigen CG/Lanczos-Schritten geschaetzt.
+ *
+ */
+class Preconditioner_Chebyshev : public Preconditioner
+{
+
+
+protected:
+  int                             degree;             // Anzahl Chebyshev-Schritte
+  int                             lanczos_ite;        // CG-Schritte fuer die Eigenwertschaetzung
+  double                          lambda_min;         // untere Schranke der Eigenwerte von C*A
+  double                          lambda_max;         // obere Schranke der Eigenwerte von C*A
+  Matrix const                   *a;                  // Matrix aus setup
+  Preconditioner                 *inner;              // innerer Vorkonditionierer C
+  Preconditioner_Jacobi           jacobi;             // Standard fuer inner
+
+  mutable Array1D<double>         r;                  // Arbeitsvektor (Residuum)
+  mutable Array1D<double>         h;                  // Arbeitsvektor (C*r)
+  mutable Array1D<double>         d;                  // Arbeitsvektor (Korrektur)
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Preconditioner_Chebyshev (
+      int                         _degree  = 4,        // Anzahl Chebyshev-Schritte (i)
+      int                         _lanczos = 10,       // CG-Schritte fuer die Eigenwertschaetzung (i)
+      Preconditioner*             _inner   = NULL      // innerer Vorkonditionierer, NULL fuer Jacobi (i)
+      )
+  {
+    degree      = _degree < 1 ? 1 : _degree;
+    lanczos_ite = _lanczos;
+    lambda_min  = 0.0;
+    lambda_max  = 0.0;
+    a           = NULL;
+    inner       = (_inner != NULL) ? _inner : &jacobi;
+  }
+
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_CHEBYSHEV_H_ */
@@ -0,0 +1,83 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_GMG_H_
+#define PRECONDITIONER_GMG_H_
+
+
+/** Geometrisches Mehrgitterverfahren fuer die strukturierten Netze aus
+ *  Discretization als Vorkonditionierer fuer Solver_CG.
+ *  - die groeberen Level sind eigene Diskretisierungen mit halbierter
+ *    Unterteilung (div_x+1)/2, (div_y+1)/2
+ *  - Prolongation P ist die bilineare Interpolation zwischen den Q1-Netzen,
+ *    Restriktion R = P^T
+ *  Bei geraden Unterteilungen sind die Q1-Raeume geschachtelt, die neu
+ *  assemblierte Grobgittermatrix stimmt dann mit dem Galerkin-Produkt
+ *  R*A*P ueberein. Bei ungeraden Unterteilungen wird R*A*P berechnet.
+ *  Vergroebert wird bis zur Groesse coarse_size.
+ *
+ */
+class Preconditioner_GMG : public Preconditioner_Multigrid
+{
+
+
+protected:
+  Discretization*                 dis;                // feinste Diskretisierung
+  Array1D<Discretization*>        dis_c;              // erzeugte grobe Diskretisierungen
+  int                             num_dis_c;          // Anzahl grober Diskretisierungen
+
+
+  void cleanup();
+
+  static void prolongation(Discretization* _fine, Discretization* _coarse, CSR& _p);
+
+
+public:
+
+  Preconditioner_GMG(
+      Discretization*             _dis,                // Zeiger auf die Diskretisierung (i)
+      Smoother_Type               _type = SMOOTHER_CHEBYSHEV, // Typ der Glaetter (i)
+      int                         _coarse_size = 200,  // Groesse des Grobgitters (i)
+      int                         _max_levels = 10     // maximale Anzahl Level (i)
+      );
+
+  ~Preconditioner_GMG();
+
+
+  void setup(Matrix const& _a);
+  bool coarsens() const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_GMG_H_ */
@@ -0,0 +1,108 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_IC_H_
+#define PRECONDITIONER_IC_H_
+
+
+/** Unvollstaendige Cholesky-Zerlegung als Vorkonditionierer
+ *  A ~ U^T * D^-1 * U  bzw.  A ~ Ut^T * D * Ut  mit Ut = D^-1 * U (Einsen auf der Diagonalen)
+ *  - IC(0): U hat dieselbe Besetzungsstruktur wie das obere Dreieck von A
+ *  - ICT:   Auffuellung erlaubt, Eintraege kleiner tol*|a_i| werden verworfen,
+ *           pro Zeile bleiben hoechstens (Eintraege von A) + fill Eintraege
+ *  Die Zerlegung wird einmal in setup berechnet (zeilenweise IKJ-Variante auf
+ *  dem MSR-Muster), apply fuehrt nur die beiden Dreieckssysteme aus.
+ *  Bricht die Zerlegung ab (Diagonale <= 0), wird sie mit einer Verschiebung
+ *  der Diagonalen A + alpha*diag(A) wiederholt.
+ *
+ */
+class Preconditioner_IC : public Preconditioner
+{
+
+
+protected:
+  bool                            threshold;          // false: IC(0), true: ICT
+  double                          drop_tol;           // relative Abbruchschranke fuer ICT
+  int                             fill;               // zusaetzliche Eintraege pro Zeile fuer ICT
+  double                          shift;              // verwendete Verschiebung alpha der Diagonalen
+
+  int                             num_eq;             // Anzahl Gleichungen
+  Array1D<int>                    row_ptr;            // Zeilenanfaenge von Ut (Laenge num_eq+1)
+  Array1D<int>                    col;                // Spaltennummern von Ut (ohne Diagonale)
+  Array1D<double>                 val;                // Werte von Ut (ohne Diagonale)
+  Array1D<double>                 diag_inv;           // Inverse von D
+
+
+  bool factor(Matrix_MSR const& _a, double _shift);
+
+
+public:
+
+  /** Konstruktor fuer IC(0)
+   *
+   */
+  Preconditioner_IC ()
+  {
+    threshold = false;
+    drop_tol  = 0.0;
+    fill      = 0;
+    shift     = 0.0;
+    num_eq    = 0;
+  }
+
+
+
+
+  /** Konstruktor fuer ICT
+   *
+   */
+  Preconditioner_IC (
+      double                      _tol,                // relative Abbruchschranke (i)
+      int                         _fill                // zusaetzliche Eintraege pro Zeile (i)
+      )
+  {
+    threshold = true;
+    drop_tol  = _tol;
+    fill      = _fill;
+    shift     = 0.0;
+    num_eq    = 0;
+  }
+
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_IC_H_ */
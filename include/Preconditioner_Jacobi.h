@@ -0,0 +1,58 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_JACOBI_H_
+#define PRECONDITIONER_JACOBI_H_
+
+
+/** Jacobi-Vorkonditionierer C = D^-1
+ *  Die inverse Diagonale wird einmal in setup gespeichert.
+ *
+ */
+class Preconditioner_Jacobi : public Preconditioner
+{
+
+
+protected:
+  Array1D<double>                 diag_inv;           // Inverse der Diagonalen
+
+
+public:
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_JACOBI_H_ */
@@ -0,0 +1,117 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_MULTIGRID_H_
+#define PRECONDITIONER_MULTIGRID_H_
+
+
+/** Basisklasse fuer Mehrgitter-Vorkonditionierer
+ *  Die abgeleiteten Klassen bauen in setup die Hierarchie auf (Matrizen,
+ *  Prolongation P und Restriktion R je Level), die Basisklasse stellt den
+ *  V-Zyklus, die Glaetter und den direkten Loeser auf dem Grobgitter bereit.
+ *  apply fuehrt einen symmetrischen V-Zyklus mit Startwert Null aus und kann
+ *  daher als Vorkonditionierer fuer Solver_CG verwendet werden.
+ *
+ */
+class Preconditioner_Multigrid : public Preconditioner
+{
+
+
+protected:
+
+  /** Rechteckige Matrix im CSR-Format fuer P, R und Zwischenergebnisse
+   *
+   */
+  struct CSR
+  {
+    int                           num_rows;           // Anzahl Zeilen
+    int                           num_cols;           // Anzahl Spalten
+    Array1D<int>                  ptr;                // Zeilenanfaenge (Laenge num_rows+1)
+    Array1D<int>                  col;                // Spaltennummern
+    Array1D<double>               val;                // Werte
+  };
+
+
+  /** Daten eines Levels der Hierarchie
+   *
+   */
+  struct Level
+  {
+    Matrix_MSR const*             a;                  // Matrix des Levels
+    Matrix_MSR*                   a_own;              // selbst erzeugte Grobgittermatrix (sonst NULL)
+    CSR                           p;                  // Prolongation vom naechsten Level
+    CSR                           r;                  // Restriktion auf das naechste Level
+    Smoother*                     smoother;           // Glaetter (nicht auf dem groebsten Level)
+    Array1D<double>               x;                  // Naeherung
+    Array1D<double>               b;                  // rechte Seite
+    Array1D<double>               res;                // Residuum
+  };
+
+
+  Smoother_Type                   smoother_type;      // Typ der Glaetter
+  int                             max_levels;         // maximale Anzahl Level
+  int                             coarse_size;        // Groesse, ab der direkt geloest wird
+
+  int                             num_levels;         // Anzahl Level der aktuellen Hierarchie
+  Array1D<Level*>                 levels;             // Level, 0 ist das feinste
+  Solver_Cholesky*                coarse;             // direkter Loeser auf dem groebsten Level
+
+
+  virtual void cleanup();
+  Level* add_level(Matrix_MSR const* _a, Matrix_MSR* _a_own);
+  void finish_setup(char const* _name);
+  void vcycle(int _l) const;
+
+  static void msr_to_csr(Matrix_MSR const& _a, CSR& _c);
+  static void multiply(CSR const& _a, CSR const& _b, CSR& _c);
+  static void transpose(CSR const& _a, CSR& _t);
+  static void mult(CSR const& _a, Array1D<double> const& _x, Array1D<double>& _y, bool _add);
+
+
+public:
+
+  Preconditioner_Multigrid(
+      Smoother_Type               _type,               // Typ der Glaetter (i)
+      int                         _coarse_size,        // Groesse des Grobgitters (i)
+      int                         _max_levels          // maximale Anzahl Level (i)
+      );
+
+  virtual ~Preconditioner_Multigrid();
+
+
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_MULTIGRID_H_ */
@@ -0,0 +1,78 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef PRECONDITIONER_SSOR_H_
+#define PRECONDITIONER_SSOR_H_
+
+
+/** SSOR-Vorkonditionierer
+ *  C^-1 = omega/(2-omega) * (D/omega + L) * D^-1 * (D/omega + U)
+ *  omega = 1 ergibt den symmetrischen Gauss-Seidel-Vorkonditionierer.
+ *  Fuer Matrix_MSR wird direkt auf den Nicht-Null-Eintraegen gearbeitet,
+ *  fuer andere Formate ueber get_entry.
+ *
+ */
+class Preconditioner_SSOR : public Preconditioner
+{
+
+
+protected:
+  double                          omega;              // Relaxationsfaktor
+  Matrix const                   *a;                  // Matrix aus setup
+  Matrix_MSR const               *msr;                // dieselbe Matrix im MSR-Format, sonst NULL
+  Array1D<double>                 diag;               // Diagonale der Matrix
+  Array1D<int>                    split;              // MSR: erster Eintrag jeder Zeile mit Spalte > Zeile
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Preconditioner_SSOR (
+      double                      _omega = 1.0         // Relaxationsfaktor, 0 < omega < 2 (i)
+      )
+  {
+    omega = _omega;
+    a     = NULL;
+    msr   = NULL;
+  }
+
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_SSOR_H_ */
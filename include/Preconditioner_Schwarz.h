@@ -0,0 +1,119 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#ifndef PRECONDITIONER_SCHWARZ_H_
+#define PRECONDITIONER_SCHWARZ_H_
+
+
+/** Ueberlappender additiver Schwarz-Vorkonditionierer (Gebietszerlegung)
+ *  C = Z*A0^-1*Z^T + sum_s R_s^T * A_s^-1 * R_s
+ *  - Teilgebiete: Knotenbloecke sub_x x sub_y des strukturierten Netzes aus
+ *    Discretization, ohne Diskretisierung zusammenhaengende Bereiche der
+ *    Freiheitsgrade
+ *  - Ueberlappung: jedes Teilgebiet wird um overlap Schichten von Nachbarn
+ *    im Matrixgraphen erweitert
+ *  - A_s = R_s*A*R_s^T wird in setup einmal direkt faktorisiert (Cholesky in
+ *    der Huelle/Skyline der lokalen Matrix), die lokalen Loesungen laufen in
+ *    apply parallel; die Faktoren sind klein genug, um im Cache zu bleiben
+ *  - Grobraum (optional): je Teilgebiet die Starrkoerperbewegungen des Kerns
+ *    ohne Ueberlappung (zwei Verschiebungen und die Drehung um den
+ *    Schwerpunkt), ohne Diskretisierung die Indikatorfunktion
+ *  Die Summe ist symmetrisch und damit fuer Solver_CG geeignet.
+ *
+ */
+class Preconditioner_Schwarz : public Preconditioner
+{
+
+
+protected:
+  int                             num_sub;            // Anzahl Teilgebiete
+  int                             overlap;            // Anzahl Ueberlappungsschichten
+  bool                            coarse;             // Grobraumkorrektur verwenden
+  int                             num_comp;           // Verschiebungsrichtungen im Grobraum (1 ohne Diskretisierung)
+  Array1D<int>                    part;               // Teilgebiet (ohne Ueberlappung) je Freiheitsgrad
+  Array1D<int>                    comp;               // Verschiebungsrichtung je Freiheitsgrad
+  Array1D<double>                 rot;                // Drehung um den Schwerpunkt des Teilgebiets je Freiheitsgrad
+
+  Array1D<int>                    sub_ptr;            // Anfang der Freiheitsgrade eines Teilgebiets in sub_dof
+  Array1D<int>                    sub_dof;            // Freiheitsgrade der Teilgebiete (mit Ueberlappung, sortiert)
+  Array1D<int>                    dof_ptr;            // Anfang der Vorkommen eines Freiheitsgrads in dof_pos
+  Array1D<int>                    dof_pos;            // Vorkommen eines Freiheitsgrads (Position in sub_dof)
+  Array1D<int>                    env_first;          // je Position in sub_dof: erste lokale Spalte der Huelle
+  Array1D<int>                    env_start;          // je Position in sub_dof: Anfang der Zeile von L in env_val
+  Array1D<double>                 env_val;            // Cholesky-Faktoren L_s, zeilenweise in der Huelle
+
+  int                             num_coarse;         // Groesse des Grobraums
+  int                             num_z;              // Eintraege von Z je Freiheitsgrad
+  Array1D<int>                    z_col;              // Spalten von Z je Freiheitsgrad
+  Array1D<double>                 z_val;              // Werte von Z je Freiheitsgrad
+  Matrix_MSR                     *coarse_a;           // A0 = Z^T*A*Z
+  Solver_Cholesky                *coarse_solver;      // Faktorisierung von A0
+
+  mutable Array1D<double>         loc;                // Arbeitsvektor R_s*in bzw. A_s^-1*R_s*in, wie sub_dof
+  mutable Array1D<double>         coarse_f;           // Arbeitsvektor Z^T*in
+  mutable Array1D<double>         coarse_u;           // Arbeitsvektor A0^-1*Z^T*in
+
+
+  void cleanup();
+  void setup_subdomains(Matrix_MSR const& _a);
+  void setup_coarse(Matrix_MSR const& _a);
+
+
+public:
+
+  Preconditioner_Schwarz(
+      Discretization*             _dis,                // Zeiger auf die Diskretisierung (i)
+      int                         _sub_x   = 0,        // Teilgebiete in x-Richtung, 0: automatisch (i)
+      int                         _sub_y   = 0,        // Teilgebiete in y-Richtung, 0: automatisch (i)
+      int                         _overlap = 1,        // Anzahl Ueberlappungsschichten (i)
+      bool                        _coarse  = true      // Grobraumkorrektur (i)
+      );
+
+  Preconditioner_Schwarz(
+      int                         _num_sub,            // Anzahl Teilgebiete (i)
+      int                         _overlap = 1,        // Anzahl Ueberlappungsschichten (i)
+      bool                        _coarse  = true      // Grobraumkorrektur (i)
+      );
+
+  ~Preconditioner_Schwarz();
+
+
+  void setup(Matrix const& _a);
+  void apply(Array1D<double> const& _in, Array1D<double>& _out) const;
+
+
+};
+
+
+#endif /* PRECONDITIONER_SCHWARZ_H_ */
@@ -0,0 +1,89 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#ifndef RENUMBERING_H_
+#define RENUMBERING_H_
+
+
+/** Strategie fuer die Nummerierung der Knoten vor der Vergabe der Freiheitsgrade
+ *
+ */
+enum Renumber_Type
+{
+  RENUMBER_NONE,                                      // Reihenfolge der Knotenliste
+  RENUMBER_RCM,                                       // Reverse Cuthill-McKee (kleine Bandbreite/Huelle)
+  RENUMBER_ND,                                        // Nested Dissection (wenig Fill-in)
+  RENUMBER_HILBERT                                    // Hilbert-Kurve ueber die Koordinaten (Cache-Lokalitaet)
+};
+
+
+
+/** Umnummerierung von Graphen (Knotengraph der Diskretisierung)
+ *  Der Graph ist im CSR-Format ohne Diagonale gegeben: die Nachbarn von v
+ *  sind adj[ptr[v]] .. adj[ptr[v+1]-1]. Ergebnis ist jeweils die neue
+ *  Reihenfolge: order[k] ist der Knoten an Position k.
+ *
+ */
+class Renumbering
+{
+
+
+protected:
+
+  static int bfs(int _start, int const* _ptr, int const* _adj, int const* _mark, int _id,
+      int* _level, int* _list, int& _num);
+
+  static int pseudo_peripheral(int _start, int const* _ptr, int const* _adj, int const* _mark, int _id,
+      int* _level, int* _list);
+
+  static void dissect(int* _set, int _size, int const* _ptr, int const* _adj, int* _mark, int& _next_id,
+      int* _level, int* _list, int* _order, int& _pos);
+
+
+public:
+
+  static void order(Renumber_Type _type, int _n, int const* _ptr, int const* _adj,
+      double const* _x, double const* _y, Array1D<int>& _order);
+
+  static void rcm(int _n, int const* _ptr, int const* _adj, Array1D<int>& _order);
+  static void nested_dissection(int _n, int const* _ptr, int const* _adj, Array1D<int>& _order);
+  static void hilbert(int _n, double const* _x, double const* _y, Array1D<int>& _order);
+
+  static char const* name(Renumber_Type _type);
+
+
+};
+
+
+#endif /* RENUMBERING_H_ */
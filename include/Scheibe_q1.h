@@ -46,6 +46,11 @@ protected:
 
 
 public:
+  // Anzahl Elemente pro Block der gebuendelten Kernel (4, 8 oder 16),
+  // jede SIMD-Spur bearbeitet ein Element
+  static const int batch_size = 8;
+
+
   Scheibe_q1();
   Scheibe_q1(int _id, int _n1, int _n2, int _n3, int _n4, Material *_mat, Discretization *_dis);
   ~Scheibe_q1(){};
@@ -54,6 +59,13 @@ public:
   void stiffness_lin( Array2D<double>& _ele_stiff );
   void stress_lin();
 
+  void gather_batch(int _lane, double* _x, double* _y, double* _c, double* _d);
+  void scatter_stress(int _lane, double const* _stress);
+
+  static void stiffness_lin_batch(double const* _x, double const* _y, double const* _c, double* _ke);
+  static void stress_lin_batch(double const* _x, double const* _y, double const* _c, double const* _d,
+      double* _stress);
+
 
   /** Ausgabe der Konnektivitt in einen Stream
    *
@@ -0,0 +1,96 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SMOOTHER_H_
+#define SMOOTHER_H_
+
+
+/** verfuegbare Glaetter fuer Mehrgitterverfahren
+ *
+ */
+enum Smoother_Type
+{
+  SMOOTHER_JACOBI,
+  SMOOTHER_CHEBYSHEV,
+  SMOOTHER_GAUSS_SEIDEL
+};
+
+
+
+/** abstrakte Klasse zur Beschreibung eines Glaetters fuer Mehrgitterverfahren
+ *  - setup: einmalige Vorbereitung fuer die Matrix eines Levels
+ *  - smooth: einige Glaettungsschritte fuer a*x=b, x wird als Startwert verwendet
+ *  Die Glaetter sind so aufgebaut, dass Vor- und Nachglaettung zusammen einen
+ *  symmetrischen Vorkonditionierer fuer Solver_CG ergeben.
+ *
+ */
+class Smoother
+{
+
+
+protected:
+  Matrix_MSR const               *a;                  // Matrix aus setup
+  Array1D<double>                 diag_inv;           // Inverse der Diagonalen
+  Array1D<double>                 res;                // Arbeitsvektor
+
+
+public:
+
+  /** Default-Konstruktor
+   *
+   */
+  Smoother()
+  {
+    a = NULL;
+  }
+
+
+  virtual ~Smoother() {};
+
+
+  virtual void setup(Matrix_MSR const& a) = 0;
+  virtual void smooth(Array1D<double> const& b, Array1D<double>& x) = 0;
+
+
+  static Smoother* create(Smoother_Type _type);
+  static double estimate_lambda_max(Matrix_MSR const& _a, Array1D<double> const& _diag_inv, int _ite = 15);
+
+
+};
+
+
+#include "Smoother_Jacobi.h"
+#include "Smoother_Chebyshev.h"
+#include "Smoother_GaussSeidel.h"
+
+
+#endif /* SMOOTHER_H_ */
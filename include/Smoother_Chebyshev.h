@@ -0,0 +1,78 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SMOOTHER_CHEBYSHEV_H_
+#define SMOOTHER_CHEBYSHEV_H_
+
+
+/** Chebyshev-Polynom in D^-1*A als Glaetter
+ *  Gedaempft wird das Intervall [lambda_max/ratio, 1.1*lambda_max], d.h.
+ *  die hochfrequenten Anteile. Kommt ohne Skalarprodukte aus.
+ *
+ */
+class Smoother_Chebyshev : public Smoother
+{
+
+
+protected:
+  int                             degree;             // Grad des Polynoms
+  double                          ratio;              // Verhaeltnis lambda_max / untere Grenze
+  double                          lambda_min;         // untere Grenze des gedaempften Intervalls
+  double                          lambda_max;         // obere Grenze des gedaempften Intervalls
+  Array1D<double>                 d;                  // Arbeitsvektor (Korrektur)
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Smoother_Chebyshev (
+      int                         _degree = 2,         // Grad des Polynoms (i)
+      double                      _ratio  = 30.0       // Verhaeltnis lambda_max / untere Grenze (i)
+      )
+  {
+    degree     = _degree;
+    ratio      = _ratio;
+    lambda_min = 0.0;
+    lambda_max = 0.0;
+  }
+
+
+  void setup(Matrix_MSR const& _a);
+  void smooth(Array1D<double> const& _b, Array1D<double>& _x);
+
+
+};
+
+
+#endif /* SMOOTHER_CHEBYSHEV_H_ */
@@ -0,0 +1,91 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SMOOTHER_GAUSSSEIDEL_H_
+#define SMOOTHER_GAUSSSEIDEL_H_
+
+
+/** Mehrfarben-Gauss-Seidel/SOR als Glaetter
+ *  Die Zeilen werden nach einer Faerbung des Matrixgraphen bearbeitet,
+ *  alle Zeilen einer Farbe sind entkoppelt und werden parallel
+ *  aktualisiert. Ein Glaettungsschritt besteht aus einem Vorwaerts- und
+ *  einem Rueckwaertsdurchlauf ueber die Farben (symmetrisch, SSOR).
+ *
+ */
+class Smoother_GaussSeidel : public Smoother
+{
+
+
+protected:
+  int                             sweeps;             // Anzahl Glaettungsschritte
+  double                          omega;              // Relaxationsfaktor
+  int                             num_colors;         // Anzahl Farben
+  Array1D<int>                    color_ptr;          // Beginn jeder Farbe in rows
+  Array1D<int>                    rows;               // Zeilen nach Farben sortiert
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Smoother_GaussSeidel (
+      int                         _sweeps = 1,         // Anzahl Glaettungsschritte (i)
+      double                      _omega  = 1.0        // Relaxationsfaktor, 0 < omega < 2 (i)
+      )
+  {
+    sweeps     = _sweeps;
+    omega      = _omega;
+    num_colors = 0;
+  }
+
+
+  void setup(Matrix_MSR const& _a);
+  void smooth(Array1D<double> const& _b, Array1D<double>& _x);
+
+  double sweep(Array1D<double> const& _b, Array1D<double>& _x, bool _backward);
+
+
+  /** Anzahl der Farben aus setup
+   *
+   */
+  int get_num_colors() const
+  {
+    return num_colors;
+  }
+
+
+};
+
+
+#endif /* SMOOTHER_GAUSSSEIDEL_H_ */
@@ -0,0 +1,74 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SMOOTHER_JACOBI_H_
+#define SMOOTHER_JACOBI_H_
+
+
+/** gedaempftes Jacobi-Verfahren als Glaetter
+ *  x = x + omega * D^-1 * (b - a*x), Standard omega = 4/(3*lambda_max(D^-1*A))
+ *
+ */
+class Smoother_Jacobi : public Smoother
+{
+
+
+protected:
+  int                             sweeps;             // Anzahl Glaettungsschritte
+  double                          omega;              // Daempfung (<= 0: automatisch)
+  double                          omega_used;         // verwendete Daempfung
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Smoother_Jacobi (
+      int                         _sweeps = 2,         // Anzahl Glaettungsschritte (i)
+      double                      _omega  = -1.0       // Daempfung, <= 0 fuer automatische Wahl (i)
+      )
+  {
+    sweeps     = _sweeps;
+    omega      = _omega;
+    omega_used = _omega;
+  }
+
+
+  void setup(Matrix_MSR const& _a);
+  void smooth(Array1D<double> const& _b, Array1D<double>& _x);
+
+
+};
+
+
+#endif /* SMOOTHER_JACOBI_H_ */
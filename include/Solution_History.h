@@ -0,0 +1,120 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#ifndef SOLUTION_HISTORY_H_
+#define SOLUTION_HISTORY_H_
+
+
+/** Art des Startwerts fuer iterative Loeser
+ *
+ */
+enum Guess_Type
+{
+  GUESS_ZERO,                                         // u = 0
+  GUESS_PREVIOUS,                                     // letzte Loesung
+  GUESS_EXTRAPOLATE,                                  // quadratisch durch die letzten drei Loesungen
+  GUESS_PROJECTION                                    // Galerkin-Projektion auf die letzten Loesungen
+};
+
+
+
+/** Verlauf der letzten Loesungen fuer Laststeigerung und Zeitschritte
+ *  Liefert Startwerte fuer iterative Loeser (Solver_CG, ...):
+ *  - Extrapolation: Polynom vom Grad p durch die letzten p+1 Loesungen bei
+ *    gleichen Schrittweiten, u = sum_j (-1)^j * (p+1 ueber j+1) * u_{n-j}
+ *  - Projektion: u = X*c mit (X^T*A*X)*c = X^T*f, also die in der Energienorm
+ *    beste Naeherung im Raum der gespeicherten Loesungen. Die Extrapolation
+ *    liegt im selben Raum, die Projektion ist also nie schlechter.
+ *  Gespeichert werden die letzten depth Loesungen in einem Ringpuffer.
+ *
+ */
+class Solution_History
+{
+
+
+protected:
+  int                             depth;              // Anzahl gespeicherter Loesungen
+  int                             num;                // Anzahl bisher gespeicherter (<= depth)
+  int                             head;               // Platz der naechsten Loesung im Ringpuffer
+  Array1D< Array1D<double> >      hist;               // Ringpuffer der Loesungen
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solution_History (
+      int                         _depth = 4           // Anzahl gespeicherter Loesungen (i)
+      )
+  {
+    depth = _depth;
+    num   = 0;
+    head  = 0;
+    hist  = Array1D< Array1D<double> >(depth);
+  }
+
+
+  /** Loesung mit Alter k (0 = neueste)
+   *
+   */
+  Array1D<double> const& get_solution(int _k) const
+  {
+    return hist[ (head - 1 - _k + 2*depth) % depth ];
+  }
+
+
+  int get_num() const
+  {
+    return num;
+  }
+
+
+  void reset()
+  {
+    num  = 0;
+    head = 0;
+  }
+
+
+  void add(Array1D<double> const& _u);
+  void extrapolate(Array1D<double>& _u, int _order = 1) const;
+  void project(Matrix const& _a, Array1D<double> const& _f, Array1D<double>& _u) const;
+  void guess(Guess_Type _type, Matrix const& _a, Array1D<double> const& _f, Array1D<double>& _u) const;
+
+
+};
+
+
+#endif /* SOLUTION_HISTORY_H_ */
@@ -35,8 +35,16 @@ mvs@ibb.uni-stuttgart.de
 #define SOLVER_H_
 
 
+#include "Solver_Telemetry.h"
+
+
 
 /** abstrakte Klasse zur Beschreibung eines linearen Loesers
+ *  Die Loesung ist in zwei Schritte aufgeteilt:
+ *  - factorize: einmalige Vorbereitung fuer eine Matrix (Faktorisierung,
+ *    Vorkonditionierer, ...), das Ergebnis wird im Loeser gespeichert
+ *  - solve: Loesung fuer eine oder mehrere rechte Seiten mit der
+ *    gespeicherten Faktorisierung
  *
  */
 class Solver
@@ -45,6 +53,38 @@ class Solver
 
 protected:
   bool                            factorized;         // Faktorisierung wurde durchgefuehrt und gespeichert
+  Matrix                         *matrix;             // Matrix, zu der die gespeicherte Faktorisierung gehoert
+  Solver_Telemetry               *telemetry;          // Aufzeichnung des Verlaufs (oder NULL)
+
+
+
+
+  /** Meldungen an die Telemetrie, ohne Wirkung falls keine gesetzt ist
+   *
+   */
+  void telemetry_begin(Telemetry_Phase _phase)
+  {
+    if (telemetry != NULL)
+      telemetry->begin(_phase);
+  }
+
+  void telemetry_end(Telemetry_Phase _phase)
+  {
+    if (telemetry != NULL)
+      telemetry->end(_phase);
+  }
+
+  void telemetry_iteration(int _ite, double _res_norm, double _alpha = 0.0, double _beta = 0.0)
+  {
+    if (telemetry != NULL)
+      telemetry->iteration(_ite, _res_norm, _alpha, _beta);
+  }
+
+  void telemetry_finish(Convergence_Reason _reason, int _ite, double _res_norm)
+  {
+    if (telemetry != NULL)
+      telemetry->finish(_reason, _ite, _res_norm);
+  }
 
 
 public:
@@ -54,21 +94,159 @@ public:
   Solver()
   {
     factorized = false;
+    matrix     = NULL;
+    telemetry  = NULL;
   };
 
 
   virtual ~Solver() {};
 
 
-  virtual void solve(Matrix& a, Array1D<double>& u, Array1D<double>& f) = 0;
+  virtual void solve(Array1D<double>& u, Array1D<double>& f) = 0;
+
+
+
+
+  /** Vorbereitung des Loesers fuer die Matrix a
+   *  Direkte Loeser faktorisieren hier die Matrix, iterative Loeser merken
+   *  sich die Matrix. Abgeleitete Klassen rufen diese Funktion am Ende auf.
+   *
+   */
+  virtual void factorize(
+      Matrix&                     _a                   // Matrix des LGS (i)
+      )
+  {
+    matrix     = &_a;
+    factorized = true;
+    _a.set_factorized(true);
+    return;
+  }
+
+
+
+
+  /** Loesung fuer mehrere rechte Seiten
+   *  Jede Spalte von f ist eine rechte Seite (Groesse n x Anzahl Lastfaelle),
+   *  die zugehoerige Loesung steht in der gleichen Spalte von u.
+   *  Standard: jede Spalte wird einzeln geloest.
+   *
+   */
+  virtual void solve(
+      Array2D<double>&            _u,                  // Loesungen (o)
+      Array2D<double>&            _f                   // rechte Seiten (i)
+      )
+  {
+    int n    = _f.get_size_1();
+    int nrhs = _f.get_size_2();
+
+    Array1D<double> u(n);
+    Array1D<double> f(n);
+
+    for (int c=0; c<nrhs; c++)
+    {
+      for (int i=0; i<n; i++)
+      {
+        f[i] = _f[i][c];
+        u[i] = _u[i][c];
+      }
+
+      solve(u, f);
+
+      for (int i=0; i<n; i++)
+        _u[i][c] = u[i];
+    }
+
+    return;
+  }
+
+
+
+
+  /** Loesung des LGS a*u=f
+   *  Die Faktorisierung wird nur neu berechnet, wenn noch keine fuer die
+   *  Matrix a vorliegt oder a seitdem neu assembliert wurde.
+   *
+   */
+  void solve(
+      Matrix&                     _a,                  // Matrix des LGS (i)
+      Array1D<double>&            _u,                  // Loesungsvektor (o)
+      Array1D<double>&            _f                   // rechte Seite Vektor (i)
+      )
+  {
+    if ( !factorized || matrix != &_a || !_a.get_factorized() )
+      factorize(_a);
+
+    solve(_u, _f);
+    return;
+  }
+
+
+
+
+  /** Setzt die Aufzeichnung des Verlaufs fuer factorize und solve
+   *
+   */
+  void set_telemetry(
+      Solver_Telemetry*           _telemetry           // Telemetrie, NULL zum Abschalten (i)
+      )
+  {
+    telemetry = _telemetry;
+    return;
+  }
+
+
+
+
+  /** Fragt ab, ob eine Faktorisierung gespeichert ist
+   *
+   */
+  bool get_factorized()
+  {
+    return factorized;
+  }
+
+
+
+
+  /** Skalarprodukt zweier Vektoren
+   *
+   */
+  static double dot(
+      Array1D<double> const&      _x,                  // erster Vektor (i)
+      Array1D<double> const&      _y                   // zweiter Vektor (i)
+      )
+  {
+    int n = _x.get_size();
+    double const* x = _x.get_dataptr();
+    double const* y = _y.get_dataptr();
+    double sum = 0.0;
+
+    #pragma omp parallel for reduction(+:sum) schedule(static)
+    for (int i=0; i<n; i++)
+      sum += x[i]*y[i];
+
+    return sum;
+  }
 
 
 };
 
 
 #include "Solver_LU.h"
+#include "Solver_Cholesky.h"
+#include "Smoother.h"
+#include "Preconditioner.h"
 #include "Solver_CG.h"
+#include "Solver_PipeCG.h"
+#include "Solver_BlockCG.h"
+#include "Solver_RecycleCG.h"
+#include "Solver_Chebyshev.h"
+#include "Solver_FloatCG.h"
 #include "Solver_GS.h"
+#include "Solver_MultiColorGS.h"
+#include "Solver_Refinement.h"
+#include "Autotuner.h"
+#include "Solution_History.h"
 
 
 #endif /* SOLVER_H_ */
@@ -0,0 +1,73 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SOLVER_BLOCKCG_H_
+#define SOLVER_BLOCKCG_H_
+
+
+/** Block-CG fuer mehrere rechte Seiten (Lastfaelle) mit derselben Matrix
+ *  Alle Systeme werden gemeinsam iteriert, die Suchrichtungen aller Systeme
+ *  spannen einen gemeinsamen Raum auf. Pro Iteration wird die Matrix nur
+ *  einmal gelesen (Block-Matrix-Vektor-Produkt).
+ *  - die Suchrichtungen werden in jeder Iteration A-orthonormiert, linear
+ *    abhaengige Richtungen werden dabei verworfen
+ *  - konvergierte Systeme werden aus dem Block entfernt (Deflation)
+ *  Fuer eine einzelne rechte Seite wird das normale CG verwendet.
+ *
+ */
+class Solver_BlockCG : public Solver_CG
+{
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_BlockCG (
+      double                      _tol,                // Abbruchschranke fuer Iteration
+      int                         _max                 // maximale Anzahl Iterationen
+      )
+    : Solver_CG(_tol, _max)
+  {
+  }
+
+
+  using Solver_CG::solve;
+
+  void solve(Array2D<double>& _u, Array2D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_BLOCKCG_H_ */
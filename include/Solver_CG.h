@@ -42,6 +42,9 @@ protected:
   double                          tol_ite;                // Abbruchschranke fuer Iteration
   int                             max_ite;                // maximale ANzahl Iterationen
 
+  Preconditioner                 *precond;                // verwendeter Vorkonditionierer
+  Preconditioner_Jacobi           jacobi;                 // Standard-Vorkonditionierer
+
 
 public:
 
@@ -55,11 +58,34 @@ public:
   {
     tol_ite = _tol;
     max_ite = _max;
+    precond = &jacobi;
+  }
+
+
+
+
+  /** Setzt den Vorkonditionierer fuer diesen Loeser
+   *  setup wird in factorize einmal fuer die Matrix aufgerufen, danach
+   *  wird der Vorkonditionierer fuer alle folgenden solve verwendet.
+   *
+   */
+  void set_precond(
+      Preconditioner*             _p                   // Vorkonditionierer, NULL fuer Jacobi (i)
+      )
+  {
+    precond    = (_p != NULL) ? _p : &jacobi;
+    factorized = false;
+    return;
   }
 
 
-  void solve(Matrix& _a, Array1D<double>& _u, Array1D<double>& _f);
-  Array1D<double> precond(Matrix&, Array1D<double>&);
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+  static void estimate_bounds(Matrix const& _a, Preconditioner const& _precond, int _steps,
+                              double& _lambda_min, double& _lambda_max, double _tol = 0.0);
   
 
 };
@@ -0,0 +1,92 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_CHEBYSHEV_H_
+#define SOLVER_CHEBYSHEV_H_
+
+
+/** vorkonditionierte Chebyshev-Iteration
+ *  Im Gegensatz zu CG werden in der Iteration keine Skalarprodukte
+ *  benoetigt, die Koeffizienten folgen allein aus dem Intervall
+ *  [lambda_min, lambda_max] der Eigenwerte von C*A. Das Intervall wird in
+ *  factorize mit CG/Lanczos-Schritten geschaetzt, ab lanczos_ite Schritten
+ *  bis sich lambda_min nicht mehr wesentlich aendert.
+ *  Die Konvergenzrate haengt nur von sqrt(lambda_max/lambda_min) ab, CG
+ *  nutzt dagegen die Verteilung der Eigenwerte. Mit Jacobi braucht das
+ *  Verfahren daher ein Vielfaches der CG-Iterationen, sinnvoll ist es mit
+ *  einem Vorkonditionierer wie Mehrgitter, der die Kondition beschraenkt.
+ *  Das Residuum wird nur alle check_ite Iterationen geprueft.
+ *  Vorkonditionierer wie bei Solver_CG ueber set_precond.
+ *
+ */
+class Solver_Chebyshev : public Solver_CG
+{
+
+
+protected:
+  int                             lanczos_ite;            // minimale CG-Schritte fuer die Eigenwertschaetzung
+  int                             check_ite;              // Iterationen zwischen Konvergenzpruefungen
+  double                          lambda_min;             // untere Schranke der Eigenwerte von C*A
+  double                          lambda_max;             // obere Schranke der Eigenwerte von C*A
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_Chebyshev (
+      double                      _tol,                // Abbruchschranke fuer Iteration
+      int                         _max,                // maximale Anzahl Iterationen
+      int                         _lanczos = 10,       // minimale CG-Schritte fuer die Eigenwertschaetzung
+      int                         _check   = 10        // Iterationen zwischen Konvergenzpruefungen
+      )
+    : Solver_CG(_tol, _max)
+  {
+    lanczos_ite = _lanczos;
+    check_ite   = _check < 1 ? 1 : _check;
+    lambda_min  = 0.0;
+    lambda_max  = 0.0;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_CHEBYSHEV_H_ */
@@ -0,0 +1,103 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SOLVER_CHOLESKY_H_
+#define SOLVER_CHOLESKY_H_
+
+
+/** Loeser mit Cholesky-Faktorisierung A = L*L^T (dense, symmetrisch positiv definit)
+ *  Es wird nur das untere Dreieck verwendet und zeilenweise gepackt
+ *  gespeichert (Zeile i beginnt bei i*(i+1)/2), d.h. halber Speicher
+ *  gegenueber Solver_LU. Eine Pivotsuche ist nicht noetig.
+ *  Geblockte rechts-schauende Variante: Diagonalblock, Panel darunter,
+ *  symmetrische Aktualisierung der Restmatrix (parallel mit OpenMP).
+ *  Der Typ T legt die Genauigkeit des Faktors fest (double oder float,
+ *  siehe Solver_Cholesky und Solver_FloatCholesky), Vorwaerts- und
+ *  Rueckwaertseinsetzen rechnen immer in double.
+ *
+ */
+template <class T>
+class Solver_Cholesky_T : public Solver
+{
+
+
+protected:
+  Array1D<T>            l;                  // unteres Dreieck von L, zeilenweise gepackt
+  int                   num_eq;             // Anzahl Gleichungen
+  int                   block_size;         // Anzahl Spalten eines Panels
+
+
+  /** Zeiger auf den Anfang der Zeile i von L
+   *
+   */
+  T* row(
+      int                         _i                   // Zeilennummer (i)
+      )
+  {
+    return l.get_dataptr() + (long)_i*(_i+1)/2;
+  }
+
+
+  void factor_diagonal(int _k0, int _k1);
+  void factor_panel(int _k0, int _k1);
+  void update_trailing(int _k0, int _k1);
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_Cholesky_T (
+      int                         _nb = 64             // Anzahl Spalten eines Panels (i)
+      )
+  {
+    num_eq     = 0;
+    block_size = _nb;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+  void solve(Array2D<double>& _u, Array2D<double>& _f);
+
+
+};
+
+
+typedef Solver_Cholesky_T<double> Solver_Cholesky;
+typedef Solver_Cholesky_T<float>  Solver_FloatCholesky;
+
+
+#endif /* SOLVER_CHOLESKY_H_ */
@@ -0,0 +1,88 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_FLOATCG_H_
+#define SOLVER_FLOATCG_H_
+
+
+/** CG-Verfahren in einfacher Genauigkeit (float) fuer MSR-Matrizen
+ *  Die Werte der Matrix und alle Vektoren der Iteration werden als float
+ *  gespeichert, die Indizes werden von der MSR-Matrix uebernommen. Das
+ *  Matrix-Vektor-Produkt liest damit etwa ein Drittel weniger Daten.
+ *  Skalarprodukte werden in double aufsummiert, vorkonditioniert wird mit
+ *  Jacobi. Abbruch bei relativer Reduktion des Residuums um rel_tol.
+ *  Gedacht als innerer Loeser fuer Solver_Refinement, kann die geforderte
+ *  Genauigkeit nicht erreicht werden, wird ohne Fehler abgebrochen.
+ *
+ */
+class Solver_FloatCG : public Solver
+{
+
+
+protected:
+  double                          rel_tol;                // relative Abbruchschranke
+  int                             max_ite;                // maximale Anzahl Iterationen
+  Matrix_MSR const               *msr;                    // MSR-Matrix fuer die Indizes
+  Array1D<float>                  value;                  // Werte der Matrix (MSR-Anordnung)
+  Array1D<float>                  diag_inv;               // Inverse der Diagonalen
+
+
+  void mult(float const* _x, float* _y) const;
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_FloatCG (
+      double                      _rel_tol = 1e-4,     // relative Abbruchschranke (i)
+      int                         _max     = 10000     // maximale Anzahl Iterationen (i)
+      )
+  {
+    rel_tol = _rel_tol;
+    max_ite = _max;
+    msr     = NULL;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_FLOATCG_H_ */
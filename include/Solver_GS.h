@@ -30,10 +30,25 @@ mvs@ibb.uni-stuttgart.de
 */
 
 
+
 #ifndef SOLVER_GS_H_
 #define SOLVER_GS_H_
 
 
+/** Gauss-Seidel/SOR/SSOR-Loeser
+ *  Die Durchlaeufe arbeiten nur auf den gespeicherten Eintraegen einer
+ *  MSR-Matrix und aktualisieren die Loesung direkt, ein Schritt kostet
+ *  O(nnz). Andere Matrixformate werden in factorize einmalig in das
+ *  MSR-Format kopiert.
+ *  Abbruch ueber die Norm des wahren Residuums, die alle res_stride
+ *  Schritte berechnet wird. Fuer omega <= 0 wird omega automatisch
+ *  geschaetzt.
+ *  Fuer die schlanken Scheiben aus Discretization ist das Verfahren nicht
+ *  praktikabel: schon bei 10x4 Elementen braucht SOR mit geschaetztem omega
+ *  rund 6e4 Schritte, SSOR (Konvergenzfaktor ~ 1 - 2e-5 fuer jedes omega)
+ *  ueber 1e6. Dafuer CG mit Vorkonditionierer verwenden.
+ *
+ */
 class Solver_GS : public Solver
 {
 
@@ -41,6 +56,19 @@ class Solver_GS : public Solver
 protected:
   double                          tol_ite;                // Abbruchschranke fuer Iteration
   int                             max_ite;                // maximale ANzahl Iterationen
+  double                          omega;                  // Relaxationsfaktor (<= 0: automatisch)
+  double                          omega_used;             // verwendeter Relaxationsfaktor
+  bool                            symmetric;              // SSOR: Vorwaerts- und Rueckwaertsdurchlauf
+  int                             res_stride;             // Residuum alle res_stride Schritte pruefen
+  Matrix_MSR const               *msr;                    // Matrix im MSR-Format
+  Matrix_MSR                     *msr_own;                // Kopie, falls die Matrix nicht MSR ist
+  Array1D<double>                 diag_inv;               // Inverse der Diagonalen
+  Array1D<double>                 res;                    // Arbeitsvektor (Residuum)
+
+
+  void   sweep(Array1D<double> const& _f, Array1D<double>& _u, double _omega, bool _backward);
+  double convergence_factor(double _omega, int _ite);
+  double estimate_omega();
 
 
 public:
@@ -48,19 +76,42 @@ public:
   /** Konstruktor mit Parametern
    *
    */
-  Solver_GS ()
+  Solver_GS (
+      double                      _omega      = 1.0,      // Relaxationsfaktor, <= 0 fuer automatische Wahl (i)
+      bool                        _symmetric  = false,    // SSOR statt SOR (i)
+      double                      _tol        = 1e-8,     // Abbruchschranke fuer Iteration (i)
+      int                         _max        = 10000,    // maximale Anzahl Iterationen (i)
+      int                         _res_stride = 10        // Residuum alle res_stride Schritte pruefen (i)
+      )
   {
-    tol_ite = 1e-8;
-    max_ite = 10000;
+    tol_ite    = _tol;
+    max_ite    = _max;
+    omega      = _omega;
+    omega_used = _omega;
+    symmetric  = _symmetric;
+    res_stride = _res_stride < 1 ? 1 : _res_stride;
+    msr        = NULL;
+    msr_own    = NULL;
   }
 
 
-  void solve(Matrix& _a, Array1D<double>& _u, Array1D<double>& _f);
+  /** Destruktor
+   *
+   */
+  ~Solver_GS()
+  {
+    delete msr_own;
+  }
 
 
-};
+  void factorize(Matrix& _a);
 
+  using Solver::solve;
+
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
 
-#endif /* SOLVER_GS_H_ */
+
+};
 
 
+#endif /* SOLVER_GS_H_ */
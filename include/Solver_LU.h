@@ -34,6 +34,15 @@ mvs@ibb.uni-stuttgart.de
 #define SOLVER_LU_H_
 
 
+/** Loeser mit LU-Faktorisierung (dense)
+ *  Geblockte rechts-schauende Faktorisierung mit Spaltenpivotisierung:
+ *  ein Panel aus block_size Spalten wird unblockiert faktorisiert, danach
+ *  wird die Restmatrix mit einem Matrix-Matrix-Produkt (BLAS-3) aktualisiert.
+ *  Die Aktualisierung der Restmatrix wird mit OpenMP auf die Threads verteilt.
+ *  Die Faktoren werden im Loeser gespeichert, jedes weitere solve kostet
+ *  nur noch Vorwaerts- und Rueckwaertseinsetzen.
+ *
+ */
 class Solver_LU : public Solver
 {
 
@@ -42,13 +51,34 @@ protected:
   Array2D<double>       lu;
   Array1D<int>          swap;
 
+  int                   block_size;         // Anzahl Spalten eines Panels
+
+
+  void factor_panel(int _k0, int _nb);
+  void update_trailing(int _k0, int _nb);
+
 
 public:
-  void solve(Matrix& _a, Array1D<double>& _u, Array1D<double>& _f);
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_LU (
+      int                         _nb = 64             // Anzahl Spalten eines Panels (i)
+      )
+  {
+    block_size = _nb;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+  void solve(Array2D<double>& _u, Array2D<double>& _f);
 
 
 };
 
 
 #endif /* SOLVER_LU_H_ */
-
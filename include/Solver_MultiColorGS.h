@@ -0,0 +1,88 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_MULTICOLORGS_H_
+#define SOLVER_MULTICOLORGS_H_
+
+
+/** Gauss-Seidel/SOR-Loeser fuer MSR-Matrizen mit Mehrfarben-Ordnung
+ *  Die Freiheitsgrade werden nach einer Faerbung des Matrixgraphen
+ *  sortiert, die Zeilen einer Farbe werden parallel aktualisiert.
+ *  Abbruch wie in Solver_GS ueber die Norm des wahren Residuums, die
+ *  alle res_stride Schritte berechnet wird.
+ *
+ */
+class Solver_MultiColorGS : public Solver
+{
+
+
+protected:
+  double                          tol_ite;            // Abbruchschranke fuer Iteration
+  int                             max_ite;            // maximale Anzahl Iterationen
+  int                             res_stride;         // Residuum alle res_stride Schritte pruefen
+  Smoother_GaussSeidel            gs;                 // Mehrfarben-Durchlauf
+  Matrix_MSR const               *msr;                // Matrix im MSR-Format
+  Array1D<double>                 res;                // Arbeitsvektor (Residuum)
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_MultiColorGS (
+      double                      _omega = 1.0,        // Relaxationsfaktor, 0 < omega < 2 (i)
+      double                      _tol   = 1e-8,       // Abbruchschranke fuer Iteration (i)
+      int                         _max   = 10000,      // maximale Anzahl Iterationen (i)
+      int                         _res_stride = 10     // Residuum alle res_stride Schritte pruefen (i)
+      )
+    : gs(1, _omega)
+  {
+    tol_ite    = _tol;
+    max_ite    = _max;
+    res_stride = _res_stride < 1 ? 1 : _res_stride;
+    msr        = NULL;
+  }
+
+
+  void factorize(Matrix& _a);
+
+  using Solver::solve;
+
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_MULTICOLORGS_H_ */
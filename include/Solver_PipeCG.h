@@ -0,0 +1,86 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+#ifndef SOLVER_PIPECG_H_
+#define SOLVER_PIPECG_H_
+
+
+/** Pipelined CG nach Ghysels und Vanroose
+ *  Mathematisch gleichwertig zu Solver_CG, aber pro Iteration nur eine
+ *  Reduktion: die beiden Skalarprodukte werden zusammen mit allen
+ *  Vektor-Updates in einer einzigen parallelen Schleife berechnet.
+ *  Vorkonditionierer und Matrix-Vektor-Produkt haengen nicht vom Ergebnis
+ *  dieser Reduktion ab. Dafuer werden vier zusaetzliche Vektoren benoetigt.
+ *  Mit OpenMP allein wird dabei nichts ueberlappt, gespart wird nur die
+ *  zweite Reduktion je Iteration. Da die Rekursionen die Konvergenz
+ *  verzoegern, ist das Verfahren hier langsamer als Solver_CG und lohnt
+ *  sich erst, wenn globale Reduktionen teuer sind (verteilter Speicher).
+ *  Da die rekursiv berechneten Vektoren durch Rundungsfehler vom wahren
+ *  Residuum abweichen, werden sie neu berechnet, sobald die mitgefuehrte
+ *  Schranke dieser Abweichung zu gross wird (Cools/Vanroose). Abgebrochen
+ *  wird nur mit dem wahren Residuum.
+ *  Vorkonditionierer wie bei Solver_CG ueber set_precond.
+ *
+ */
+class Solver_PipeCG : public Solver_CG
+{
+
+
+protected:
+  int                             replace_ite;            // erzwungenes Ersetzen alle replace_ite Iterationen (0: nur nach Schranke)
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_PipeCG (
+      double                      _tol,                // Abbruchschranke fuer Iteration
+      int                         _max,                // maximale Anzahl Iterationen
+      int                         _replace = 0         // erzwungenes Ersetzen alle _replace Iterationen
+      )
+    : Solver_CG(_tol, _max)
+  {
+    replace_ite = _replace;
+  }
+
+
+  using Solver::solve;
+
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_PIPECG_H_ */
@@ -0,0 +1,111 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_RECYCLECG_H_
+#define SOLVER_RECYCLECG_H_
+
+
+/** Deflationiertes CG mit Wiederverwendung eines Unterraums (Recycling)
+ *  Fuer Folgen von Systemen mit aehnlichen Matrizen (Parameterstudien,
+ *  Zeitschritte). Ein kleiner Unterraum W aus Ritz-Vektoren zu den
+ *  kleinsten Eigenwerten wird von Loesung zu Loesung weitergegeben:
+ *  - der Startwert wird im Unterraum W korrigiert (Galerkin)
+ *  - die Suchrichtungen werden A-orthogonal zu W gehalten, die
+ *    zugehoerigen langsamen Eigenanteile sind damit aus der Iteration
+ *    entfernt (Saad/Yeung/Erhel/Guyomarc'h)
+ *  - nach jeder Loesung werden aus W und den ersten num_store
+ *    Suchrichtungen neue Ritz-Vektoren fuer die naechste Loesung bestimmt
+ *  In factorize wird A*W fuer die neue Matrix berechnet, W bleibt erhalten.
+ *  Vorkonditionierer wie bei Solver_CG ueber set_precond.
+ *
+ */
+class Solver_RecycleCG : public Solver_CG
+{
+
+
+protected:
+  int                             num_recycle;            // maximale Dimension des Unterraums W
+  int                             num_store;              // Anzahl gespeicherter Suchrichtungen
+  Array2D<double>                 w;                      // Unterraum W, n x k
+  Array2D<double>                 aw;                     // A*W, n x k
+  Array2D<double>                 waw_chol;               // Cholesky-Faktor von W^T*A*W, k x k
+  Array2D<double>                 p_store;                // gespeicherte Suchrichtungen, eine pro Zeile
+  Array2D<double>                 z;                      // Arbeitsblock Z = [W, P] orthonormiert, n x mz
+  Array2D<double>                 az;                     // Arbeitsblock A*Z, n x mz
+
+
+  void setup_deflation();
+  void coarse_solve(Array1D<double> const& _g, Array1D<double>& _c) const;
+  void update_recycle(int _num_p);
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_RecycleCG (
+      double                      _tol,                // Abbruchschranke fuer Iteration
+      int                         _max,                // maximale Anzahl Iterationen
+      int                         _recycle = 10,       // maximale Dimension des Unterraums
+      int                         _store   = 20        // Anzahl gespeicherter Suchrichtungen
+      )
+    : Solver_CG(_tol, _max)
+  {
+    num_recycle = _recycle;
+    num_store   = _store;
+  }
+
+
+  /** Unterraum verwerfen, die naechste Loesung startet wie Solver_CG
+   *
+   */
+  void reset_recycle()
+  {
+    w.resize(0, 0);
+    aw.resize(0, 0);
+    waw_chol.resize(0, 0);
+    return;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_RECYCLECG_H_ */
@@ -0,0 +1,81 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_REFINEMENT_H_
+#define SOLVER_REFINEMENT_H_
+
+
+/** Iterative Nachverbesserung mit einem inneren Loeser geringerer Genauigkeit
+ *  Das Residuum r = f - A*u wird in double mit der Originalmatrix berechnet,
+ *  die Korrektur A*d = r liefert der innere Loeser (z.B. Solver_FloatCG),
+ *  danach u = u + d. Wiederholt bis ||r|| <= tol_ite.
+ *  Der innere Loeser wird in factorize fuer dieselbe Matrix vorbereitet.
+ *
+ */
+class Solver_Refinement : public Solver
+{
+
+
+protected:
+  double                          tol_ite;                // Abbruchschranke fuer ||f - A*u||
+  int                             max_ite;                // maximale Anzahl Nachverbesserungen
+  Solver                         *inner;                  // innerer Loeser fuer die Korrektur
+
+
+public:
+
+  /** Konstruktor mit Parametern
+   *
+   */
+  Solver_Refinement (
+      Solver*                     _inner,              // innerer Loeser (i)
+      double                      _tol = 1e-8,         // Abbruchschranke fuer ||f - A*u|| (i)
+      int                         _max = 50            // maximale Anzahl Nachverbesserungen (i)
+      )
+  {
+    inner   = _inner;
+    tol_ite = _tol;
+    max_ite = _max;
+  }
+
+
+  using Solver::solve;
+
+  void factorize(Matrix& _a);
+  void solve(Array1D<double>& _u, Array1D<double>& _f);
+
+
+};
+
+
+#endif /* SOLVER_REFINEMENT_H_ */
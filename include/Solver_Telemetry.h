@@ -0,0 +1,177 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef SOLVER_TELEMETRY_H_
+#define SOLVER_TELEMETRY_H_
+
+
+/** Phasen eines Loesers, deren Zeit gemessen wird
+ *
+ */
+enum Telemetry_Phase
+{
+  PHASE_FACTORIZE,
+  PHASE_SOLVE
+};
+
+
+
+/** Grund fuer das Ende eines solve
+ *
+ */
+enum Convergence_Reason
+{
+  CONV_NONE,                                          // noch kein solve abgeschlossen
+  CONV_TOLERANCE,                                     // Abbruchschranke erreicht
+  CONV_MAX_ITE,                                       // maximale Anzahl Iterationen erreicht
+  CONV_DIRECT                                         // direkter Loeser, keine Iteration
+};
+
+
+
+/** Daten einer Iteration
+ *
+ */
+struct Telemetry_Record
+{
+  int                             ite;                // Iteration
+  double                          res_norm;           // Norm des Residuums (wie im Abbruchkriterium)
+  double                          alpha;              // Schrittweite (0 falls nicht vorhanden)
+  double                          beta;               // Koeffizient der Suchrichtung (0 falls nicht vorhanden)
+  double                          time;               // Zeit seit Beginn des solve [s]
+};
+
+
+
+/** Zusammenfassung des letzten factorize/solve
+ *
+ */
+struct Telemetry_Summary
+{
+  int                             iterations;         // Iterationen des letzten solve
+  double                          res_norm;           // Norm des Residuums am Ende
+  double                          time_factorize;     // Zeit des letzten factorize [s]
+  double                          time_solve;         // Zeit des letzten solve [s]
+  Convergence_Reason              reason;             // Grund fuer das Ende
+};
+
+
+
+/** Rueckruf-Funktion fuer jede Iteration
+ *
+ */
+typedef void (*Telemetry_Callback)(Telemetry_Record const& rec, void* data);
+
+
+
+/** Aufzeichnung des Verlaufs eines Loesers
+ *  Die Loeser melden jede Iteration (Residuum, alpha/beta, Zeit), die
+ *  letzten capacity Iterationen eines solve werden in einem Ringpuffer
+ *  gehalten. Optional wird fuer jede Iteration eine Rueckruf-Funktion
+ *  aufgerufen. Zeiten von factorize und solve werden gemessen, auch wenn
+ *  Loeser ineinander aufgerufen werden zaehlt nur die aeusserste Ebene.
+ *  Ausgabe als Zusammenfassung, CSV (Iterationen) oder JSON.
+ *  Zuordnung zu einem Loeser ueber Solver::set_telemetry.
+ *
+ */
+class Solver_Telemetry
+{
+
+
+protected:
+  int                             capacity;           // Groesse des Ringpuffers
+  Array1D<Telemetry_Record>       ring;               // Ringpuffer der Iterationen
+  int                             num_records;        // Anzahl gemeldeter Iterationen im aktuellen solve
+  Telemetry_Summary               summary;            // Zusammenfassung
+  double                          t_start[2];         // Startzeit je Phase
+  int                             depth[2];           // Schachtelungstiefe je Phase
+  Telemetry_Callback              callback;           // Rueckruf-Funktion (oder NULL)
+  void                           *callback_data;      // Daten fuer die Rueckruf-Funktion
+
+
+public:
+
+  Solver_Telemetry(int _capacity = 1000);
+
+
+  /** Setzt eine Rueckruf-Funktion fuer jede Iteration
+   *
+   */
+  void set_callback(
+      Telemetry_Callback          _callback,           // Funktion, NULL zum Abschalten (i)
+      void*                       _data = NULL         // wird an die Funktion durchgereicht (i)
+      )
+  {
+    callback      = _callback;
+    callback_data = _data;
+    return;
+  }
+
+
+  void begin(Telemetry_Phase _phase);
+  void end(Telemetry_Phase _phase);
+  void iteration(int _ite, double _res_norm, double _alpha = 0.0, double _beta = 0.0);
+  void finish(Convergence_Reason _reason, int _ite, double _res_norm);
+
+
+  /** Zusammenfassung des letzten factorize/solve
+   *
+   */
+  Telemetry_Summary const& get_summary() const
+  {
+    return summary;
+  }
+
+
+  /** Anzahl der im Ringpuffer gehaltenen Iterationen
+   *
+   */
+  int get_num_records() const
+  {
+    return min(num_records, capacity);
+  }
+
+
+  Telemetry_Record const& get_record(int _k) const;
+
+  void print_summary() const;
+  void write_csv(char const* _filename) const;
+  void write_json(char const* _filename) const;
+
+  static double wtime();
+
+
+};
+
+
+#endif /* SOLVER_TELEMETRY_H_ */
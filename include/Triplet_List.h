@@ -0,0 +1,113 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#ifndef TRIPLET_LIST_H_
+#define TRIPLET_LIST_H_
+
+
+/** Liste von (Zeile, Spalte, Wert)-Tripeln (Koordinatenformat, COO)
+ * Die Tripel werden ohne vorab bekannte Besetzungsstruktur an feste
+ * Positionen geschrieben, doppelte Eintraege sind erlaubt. compress()
+ * sortiert die Tripel mit einem parallelen, stabilen Radix-Sort nach
+ * (Zeile, Spalte) und summiert gleiche Eintraege (segmentierte Reduktion)
+ * zur komprimierten Matrix auf. Gleiche Eintraege werden in der Reihenfolge
+ * ihrer Positionen summiert, das Ergebnis haengt also nicht von der Anzahl
+ * Threads ab.
+ *
+ */
+class Triplet_List
+{
+
+
+protected:
+  int                             num_eq;             // Anzahl Zeilen/Spalten
+  int                             num;                // Anzahl Tripel
+  Array1D<unsigned long long>     key;                // Schluessel Zeile*num_eq+Spalte
+  Array1D<double>                 val;                // Werte
+
+
+  static void radix_sort(unsigned long long*& _key, double*& _val,
+      unsigned long long*& _key_tmp, double*& _val_tmp, int _num, int _bits);
+
+
+public:
+
+
+  Triplet_List(int _num_eq, int _num);
+
+
+
+  /** Destruktor
+   *
+   */
+  ~Triplet_List() { }
+
+
+
+
+  /** Setzt das Tripel an Position k
+   *  Darf fuer verschiedene Positionen parallel aufgerufen werden.
+   *
+   */
+  inline void set(
+      int                         _k,                 // Position des Tripels (i)
+      int                         _row,               // Zeile (i)
+      int                         _col,               // Spalte (i)
+      double                      _val                // Wert (i)
+      )
+  {
+    key.get_dataptr()[_k] = (unsigned long long)_row*num_eq + _col;
+    val.get_dataptr()[_k] = _val;
+  }
+
+
+
+
+  /** Rueckgabe der Anzahl Tripel
+   *
+   */
+  int get_num() const
+  {
+    return num;
+  }
+
+
+
+  int compress(Array1D<int>& _ptr, Array1D<int>& _col, Array1D<double>& _val);
+
+  Matrix_MSR* create_MSR();
+
+};
+
+
+#endif /* TRIPLET_LIST_H_ */
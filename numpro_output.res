@@ -0,0 +1,228 @@
+GiD Post Results File 1.0
+GaussPoints "gps_scheibe_q1" Elemtype Quadrilateral "Scheibe_q1"
+Number of Gauss Points: 4
+Natural Coordinates: Internal
+end gausspoints
+Result "displacement" "NumPro" 1 Vector OnNodes
+ComponentNames "comp. x", "comp. y", "unused"
+values
+1 0  0  0.0
+2 0.64728  0.681177  0.0
+3 1.22502  2.58763  0.0
+4 1.73507  5.58166  0.0
+5 2.17706  9.52781  0.0
+6 2.55106  14.2899  0.0
+7 2.85707  19.7321  0.0
+8 3.09496  25.7181  0.0
+9 3.26549  32.1122  0.0
+10 3.36623  38.7802  0.0
+11 3.3983  45.5723  0.0
+12 0  0  0.0
+13 0.32108  0.68128  0.0
+14 0.610466  2.58758  0.0
+15 0.865397  5.58167  0.0
+16 1.08641  9.52781  0.0
+17 1.27341  14.2899  0.0
+18 1.42641  19.7321  0.0
+19 1.54541  25.7182  0.0
+20 1.63039  32.1121  0.0
+21 1.68143  38.78  0.0
+22 1.69849  45.5735  0.0
+23 0  0  0.0
+24 -1.06058e-08  0.681384  0.0
+25 7.51654e-08  2.58754  0.0
+26 -3.70236e-07  5.58169  0.0
+27 1.334e-06  9.5278  0.0
+28 -2.95571e-06  14.2899  0.0
+29 -1.6322e-06  19.732  0.0
+30 5.24335e-05  25.7182  0.0
+31 -0.000265488  32.1121  0.0
+32 0.000584025  38.7792  0.0
+33 0.00179766  45.5779  0.0
+34 0  0  0.0
+35 -0.32108  0.68128  0.0
+36 -0.610466  2.58758  0.0
+37 -0.865397  5.58167  0.0
+38 -1.08641  9.5278  0.0
+39 -1.2734  14.2899  0.0
+40 -1.42643  19.732  0.0
+41 -1.54533  25.7183  0.0
+42 -1.63062  32.1123  0.0
+43 -1.68108  38.7773  0.0
+44 -1.69713  45.5869  0.0
+45 0  0  0.0
+46 -0.64728  0.681177  0.0
+47 -1.22502  2.58763  0.0
+48 -1.73507  5.58166  0.0
+49 -2.17706  9.52781  0.0
+50 -2.55106  14.2899  0.0
+51 -2.85704  19.732  0.0
+52 -3.09521  25.7181  0.0
+53 -3.2645  32.113  0.0
+54 -3.3681  38.7742  0.0
+55 -3.40462  45.5997  0.0
+end values
+Result "Cauchy" "NumPro" 1.000000 Vector OnGaussPoints "gps_scheibe_q1"
+ComponentNames "sigma xx", "sigma yy", "sigma xy"
+values
+1 578.346 0.0874406 202.731
+ 578.346 0.326333 -173.933
+ 390.014 0.326333 -173.903
+ 390.014 0.0874406 202.761
+2 516.806 0.287331 178.936
+ 516.806 -0.0581174 -154.029
+ 350.323 -0.0581174 -154.072
+ 350.323 0.287331 178.893
+3 456.134 -0.132861 160.084
+ 456.134 0.0083834 -134.498
+ 308.843 0.0083834 -134.48
+ 308.843 -0.132861 160.102
+4 395.293 0.0435061 140.332
+ 395.293 -0.00178132 -114.835
+ 267.709 -0.00178132 -114.841
+ 267.709 0.0435061 140.326
+5 334.484 -0.0112928 120.712
+ 334.484 0.00800874 -95.2237
+ 226.517 0.00800874 -95.2213
+ 226.517 -0.0112928 120.715
+6 273.676 0.00160366 101.094
+ 273.676 -0.0351969 -75.5843
+ 185.337 -0.0351969 -75.5889
+ 185.337 0.00160366 101.089
+7 212.761 -0.008706 81.4412
+ 212.761 0.100469 -55.8351
+ 144.123 0.100469 -55.8215
+ 144.123 -0.008706 81.4549
+8 152.456 0.0719629 61.7665
+ 152.456 -0.115092 -37.0234
+ 103.061 -0.115092 -37.0468
+ 103.061 0.0719629 61.7431
+9 90.2324 -0.288824 42.7635
+ 90.2324 -0.576411 -14.6139
+ 61.5437 -0.576411 -14.6498
+ 61.5437 -0.288824 42.7276
+10 28.9024 0.458591 20.2523
+ 28.9024 3.57386 2.90727
+ 20.2298 3.57386 3.29667
+ 20.2298 0.458591 20.6417
+11 253.228 0.0874293 204.947
+ 253.228 0.326291 -165.804
+ 67.8521 0.326291 -165.774
+ 67.8521 0.0874293 204.977
+12 228.232 0.287321 188.667
+ 228.232 -0.0580074 -145.488
+ 61.1546 -0.0580074 -145.531
+ 61.1546 0.287321 188.624
+13 201.057 -0.13276 168.373
+ 201.057 0.00834222 -125.996
+ 53.8729 0.00834222 -125.978
+ 53.8729 -0.13276 168.391
+14 174.306 0.0430103 148.859
+ 174.306 -0.00337653 -106.34
+ 46.7064 -0.00337653 -106.345
+ 46.7064 0.0430103 148.854
+15 147.479 -0.00973659 129.212
+ 147.479 0.0192742 -86.719
+ 39.5138 0.0192742 -86.7154
+ 39.5138 -0.00973659 129.216
+16 120.67 -3.78592e-05 109.588
+ 120.67 -0.0818103 -67.0833
+ 32.3344 -0.0818103 -67.0935
+ 32.3344 -3.78592e-05 109.578
+17 93.8634 -0.0247843 89.9585
+ 93.8634 0.212786 -47.3879
+ 25.1902 0.212786 -47.3582
+ 25.1902 -0.0247843 89.9882
+18 66.9553 0.200634 70.2222
+ 66.9553 -0.0701367 -28.2727
+ 17.7079 -0.0701367 -28.3065
+ 17.7079 0.200634 70.1884
+19 40.4358 -0.802992 51.3257
+ 40.4358 -2.53442 -6.63263
+ 11.4566 -2.53442 -6.84906
+ 11.4566 -0.802992 51.1093
+20 13.7077 1.29258 28.892
+ 13.7077 13.4796 10.5994
+ 4.56141 13.4796 12.1228
+ 4.56141 1.29258 30.4154
+21 -67.8521 -0.087443 204.977
+ -67.8521 -0.326342 -165.774
+ -253.228 -0.326342 -165.804
+ -253.228 -0.087443 204.947
+22 -61.1545 -0.287347 188.624
+ -61.1545 0.0580885 -145.531
+ -228.232 0.0580885 -145.488
+ -228.232 -0.287347 188.667
+23 -53.8735 0.13304 168.391
+ -53.8735 -0.00762548 -125.977
+ -201.058 -0.00762548 -125.995
+ -201.058 0.13304 168.373
+24 -46.7038 -0.0443894 148.853
+ -46.7038 -0.00416535 -106.35
+ -174.306 -0.00416535 -106.345
+ -174.306 -0.0443894 148.858
+25 -39.5198 0.0137294 129.216
+ -39.5198 0.0223946 -86.7006
+ -147.478 0.0223946 -86.6995
+ -147.478 0.0137294 129.217
+26 -32.3367 -0.000715473 109.579
+ -32.3367 -0.0725187 -67.1193
+ -120.686 -0.0725187 -67.1283
+ -120.686 -0.000715473 109.57
+27 -25.0853 -0.0450394 89.9706
+ -25.0853 0.101838 -47.3937
+ -93.7675 0.101838 -47.3753
+ -93.7675 -0.0450394 89.9889
+28 -18.2744 0.274613 70.27
+ -18.2744 0.599763 -27.8462
+ -67.3325 0.599763 -27.8056
+ -67.3325 0.274613 70.3106
+29 -9.99343 -1.01257 50.9384
+ -9.99343 -5.7427 -8.30858
+ -39.6169 -5.7427 -8.89985
+ -39.6169 -1.01257 50.3471
+30 -2.43387 1.64172 29.8774
+ -2.43387 26.5465 9.94708
+ -12.399 26.5465 13.0602
+ -12.399 1.64172 32.9905
+31 -390.014 -0.0874635 202.761
+ -390.014 -0.326418 -173.903
+ -578.346 -0.326418 -173.933
+ -578.346 -0.0874635 202.731
+32 -350.323 -0.287325 178.893
+ -350.323 0.0584338 -154.072
+ -516.806 0.0584338 -154.029
+ -516.806 -0.287325 178.936
+33 -308.843 0.132923 160.102
+ -308.843 -0.00932945 -134.479
+ -456.134 -0.00932945 -134.497
+ -456.134 0.132923 160.084
+34 -267.71 -0.0438415 140.325
+ -267.71 0.0041219 -114.844
+ -395.295 0.0041219 -114.838
+ -395.295 -0.0438415 140.331
+35 -226.513 0.0119757 120.719
+ -226.513 -0.0145306 -95.22
+ -334.483 -0.0145306 -95.2233
+ -334.483 0.0119757 120.716
+36 -185.346 0.00168302 101.075
+ -185.346 0.0724857 -75.5336
+ -273.65 0.0724857 -75.5248
+ -273.65 0.00168302 101.084
+37 -144.112 -0.0318634 81.4758
+ -144.112 -0.387753 -56.2466
+ -212.973 -0.387753 -56.2911
+ -212.973 -0.0318634 81.4313
+38 -103.039 0.15707 61.8295
+ -103.039 2.00145 -35.1598
+ -151.534 2.00145 -34.9292
+ -151.534 0.15707 62.06
+39 -61.6893 -0.541075 41.9144
+ -61.6893 -9.33175 -19.4445
+ -92.3688 -9.33175 -20.5434
+ -92.3688 -0.541075 40.8156
+40 -20.3735 0.971352 23.7621
+ -20.3735 37.9106 0.119156
+ -32.195 37.9106 4.73656
+ -32.195 0.971352 28.3795
+end values
@@ -35,23 +35,41 @@ mvs@ibb.uni-stuttgart.de
 #include "Element.h"
 #include "Material.h"
 #include "Solver.h"
+#include <algorithm>
 
 /** Diskretisierung vorbereiten
- *  Die Diskretisierung wird fuer die Berechnung vorbereitet.
+ *  Die Diskretisierung wird fuer die Berechnung vorbereitet. Das Gebiet
+ *  l_x * l_y wird in div_x * div_y Elemente unterteilt.
  *
  */
-Discretization::Discretization()
+Discretization::Discretization(
+    double                        _l_x,                // Laenge des Gebiets in x-Richtung (i)
+    double                        _l_y,                // Laenge des Gebiets in y-Richtung (i)
+    int                           _div_x,              // Anzahl Elemente in x-Richtung (i)
+    int                           _div_y,              // Anzahl Elemente in y-Richtung (i)
+    bool                          _verbose,            // Ausgabe auf den Bildschirm (i)
+    Renumber_Type                 _renumber            // Nummerierung der Freiheitsgrade (i)
+    )
 {
 
   num_dof_dirich = 0;
   num_dof_solve  = 0;
   num_dof_total  = 0;
 
+  verbose        = _verbose;
+  renumber       = _renumber;
 
-  printf("\n\n");
-  printf("==============================================================\n");
-  printf("Input:\n");
-  printf("==============================================================\n");
+  scatter_matrix = NULL;
+  scatter_nnz    = 0;
+
+
+  if (verbose)
+  {
+    printf("\n\n");
+    printf("==============================================================\n");
+    printf("Input:\n");
+    printf("==============================================================\n");
+  }
 
   /************************************
    *
@@ -71,20 +89,18 @@ Discretization::Discretization()
    * Read geometry data
    *
    ************************************/
-  double l_x, l_y;             // length of the domain in x and y direction
-  int div_x, div_y;            // number of elements in x and y direction
-
-  l_x    = 10;
-  l_y    =  1;
-  div_x  =  10;
-  div_y  =  4;
+  l_x    = _l_x;
+  l_y    = _l_y;
+  div_x  = _div_x;
+  div_y  = _div_y;
 
   /************************************
    *
    * Nodes
    *
    ************************************/
-  printf("%6i Nodes\n",(div_x+1)*(div_y+1));
+  if (verbose)
+    printf("%6i Nodes\n",(div_x+1)*(div_y+1));
   node.resize( (div_x+1)*(div_y+1) );
 
   for (int i=0; i<div_y+1; i++)  // loop all rows (blue)
@@ -115,7 +131,8 @@ Discretization::Discretization()
    * Elements
    *
    ************************************/
-  printf("%6i Elements\n",(div_x)*(div_y));
+  if (verbose)
+    printf("%6i Elements\n",(div_x)*(div_y));
   element.resize( (div_x)*(div_y) );
 
 
@@ -151,14 +168,23 @@ Discretization::Discretization()
   double value = 17;
   node[id]->set_bc_force(1, value);
 
-  printf("\n\n");
-  printf("==============================================================\n");
-  printf("Prepare Discretization:\n");
-  printf("==============================================================\n");
+  if (verbose)
+  {
+    printf("\n\n");
+    printf("==============================================================\n");
+    printf("Prepare Discretization:\n");
+    printf("==============================================================\n");
+  }
 
   /** - Freiheitsgradnummern werden an die Knoten verteilt */
   assign_dofs();
 
+  /** - Elemente fuer die parallele Assemblierung einfaerben */
+  color_elements();
+
+  /** - gleiche Elementsteifigkeitsmatrizen zusammenfassen */
+  build_element_cache();
+
 
 
   return;
@@ -167,9 +193,30 @@ Discretization::Discretization()
 
 
 
+/** Destruktor
+ *  Knoten, Elemente und Materialien werden geloescht.
+ *
+ */
+Discretization::~Discretization()
+{
+  for(int i=0; i < element.get_size(); i++)
+    delete element[i];
+
+  for(int i=0; i < node.get_size(); i++)
+    delete node[i];
+
+  for(int i=0; i < material.get_size(); i++)
+    delete material[i];
+}
+
+
+
+
 /** Freiheitsgradnummern an die Knoten verteilen
  *  Zuerst werden Freiheitsgradnummern an freie Freiheitsgrade verteilt,
  *  danach an Freiheitsgrade, die durch Dirichlet-RB gehalten sind.
+ *  Die Knoten werden dabei in der Reihenfolge der gewaehlten Umnummerierung
+ *  (RCM, Nested Dissection, Hilbert-Kurve) durchlaufen.
  *  Im Anschluss wird fuer alle Elemente der Diskretisierung die ID-Matrix
  *  aufgestellt.
  *
@@ -178,52 +225,96 @@ void Discretization::assign_dofs()
 {
   int counter;
 
-  // Anzahl der Freiheitsgrade zu Null setzen
-  num_dof_total   = 0;     // Anzahl aller Freiheitsgrade
-  num_dof_solve   = 0;     // Anzahl der zu loesenden Freiheitsgrade (Groesse des globale LGS)
-  num_dof_dirich  = 0;     // Anzahl der durch Dirichlet-RB festgehaltenen Freiheitsgrade
+  // Reihenfolge der Knoten
+  Array1D<int> order;
+  {
+    Array1D<int>    ptr, adj;
+    Array1D<double> x(node.get_size());
+    Array1D<double> y(node.get_size());
 
+    node_graph(ptr, adj);
+    for (int i=0; i < node.get_size(); i++)
+    {
+      x[i] = node[i]->get_x();
+      y[i] = node[i]->get_y();
+    }
 
-  /* Schleife ueber alle Knoten der Diskretisierung:
-   * Freiheitsgradnummern werden an freie Freiheitsgrade verteilt */
-  for(int i=0; i < node.get_size(); i++)
+    Renumbering::order(renumber, node.get_size(), ptr.get_dataptr(), adj.get_dataptr(),
+        x.get_dataptr(), y.get_dataptr(), order);
+  }
+
+
+  int  bw_before      = 0;
+  long profile_before = 0;
+
+  for (int pass=0; pass<2; pass++)
   {
-    Node &act_node = *node[i];
+    // Durchlauf 0 nur fuer den Vergleich: Knotenreihenfolge
+    if (pass == 0 && (renumber == RENUMBER_NONE || !verbose))
+      continue;
 
-    for (int j=0; j<2; j++)
+    // Anzahl der Freiheitsgrade zu Null setzen
+    num_dof_total   = 0;     // Anzahl aller Freiheitsgrade
+    num_dof_solve   = 0;     // Anzahl der zu loesenden Freiheitsgrade (Groesse des globale LGS)
+    num_dof_dirich  = 0;     // Anzahl der durch Dirichlet-RB festgehaltenen Freiheitsgrade
+
+
+    /* Schleife ueber alle Knoten der Diskretisierung:
+     * Freiheitsgradnummern werden an freie Freiheitsgrade verteilt */
+    for(int k=0; k < node.get_size(); k++)
     {
-      if ( !act_node.get_bc_displ(j) )
+      Node &act_node = *node[ (pass == 0) ? k : order[k] ];
+
+      for (int j=0; j<2; j++)
       {
-        act_node.dof_set(j, num_dof_total);
-        num_dof_total++;
-        num_dof_solve++;
+        if ( !act_node.get_bc_displ(j) )
+        {
+          act_node.dof_set(j, num_dof_total);
+          num_dof_total++;
+          num_dof_solve++;
+        }
       }
     }
-  }
 
 
 
-  /* Schleife ueber alle Knoten der Diskretisierung:
-   * Freiheitsgradnummern werden an festgehaltene Freiheitsgrade verteilt */
-  for(int i=0; i < node.get_size(); i++)
-  {
-    Node &act_node = *node[i];
-
-    for (int j=0; j<2; j++)
+    /* Schleife ueber alle Knoten der Diskretisierung:
+     * Freiheitsgradnummern werden an festgehaltene Freiheitsgrade verteilt */
+    for(int k=0; k < node.get_size(); k++)
     {
-      if ( act_node.get_bc_displ(j) )
+      Node &act_node = *node[ (pass == 0) ? k : order[k] ];
+
+      for (int j=0; j<2; j++)
       {
-        act_node.dof_set(j, num_dof_total);
-        num_dof_total++;
-        num_dof_dirich++;
+        if ( act_node.get_bc_displ(j) )
+        {
+          act_node.dof_set(j, num_dof_total);
+          num_dof_total++;
+          num_dof_dirich++;
+        }
       }
     }
+
+    if (pass == 0)
+      dof_envelope(bw_before, profile_before);
   }
 
 
-  printf("%6i dofs total\n",num_dof_total);
-  printf("%6i dofs constrained\n",num_dof_dirich);
-  printf("%6i dofs to solve\n",num_dof_solve);
+  if (verbose)
+  {
+    printf("%6i dofs total\n",num_dof_total);
+    printf("%6i dofs constrained\n",num_dof_dirich);
+    printf("%6i dofs to solve\n",num_dof_solve);
+
+    if (renumber != RENUMBER_NONE)
+    {
+      int  bw;
+      long profile;
+      dof_envelope(bw, profile);
+      printf("renumbering (%s): bandwidth %d -> %d, profile %ld -> %ld\n",
+          Renumbering::name(renumber), bw_before, bw, profile_before, profile);
+    }
+  }
 
 
   /* Schleife ueber alle Elemente der Diskretisierung:
@@ -262,9 +353,256 @@ void Discretization::assign_dofs()
 
 
 
+/** Knotengraph: zwei Knoten sind benachbart, wenn sie in einem Element liegen
+ *  CSR-Format ohne Diagonale, die Nachbarn eines Knotens sind aufsteigend sortiert.
+ *
+ */
+void Discretization::node_graph(
+    Array1D<int>&              _ptr,                 // Zeilenanfaenge (o)
+    Array1D<int>&              _adj                  // Nachbarn (o)
+    )
+{
+  int num_node = node.get_size();
+
+  // obere Schranke: 4 Knoten je angrenzendem Element
+  _ptr = Array1D<int>(num_node+1);
+  _ptr[0] = 0;
+  for (int i=0; i<num_node; i++)
+    _ptr[i+1] = _ptr[i] + 4*node[i]->element_get_size();
+
+  Array1D<int> tmp(max(_ptr[num_node], 1));
+  int*         t = tmp.get_dataptr();
+  int          c = 0;
+
+  for (int i=0; i<num_node; i++)
+  {
+    Node &act_node = *node[i];
+    int   c0       = c;
+
+    for (int j=0; j<act_node.element_get_size(); j++)
+    {
+      Element &act_element = *act_node.element_get(j);
+      for (int l=0; l<4; l++)
+      {
+        int id = act_element.nodes_get(l)->get_id();
+        if (id != i)
+          t[c++] = id;
+      }
+    }
+
+    std::sort(t+c0, t+c);
+    c = (int) (std::unique(t+c0, t+c) - t);
+    _ptr[i+1] = c;
+  }
+
+  _adj = Array1D<int>(max(c, 1));
+  for (int k=0; k<c; k++)
+    _adj[k] = t[k];
+
+  return;
+}
+
+
+
+
+/** Bandbreite und Profil (Huelle) der Matrix der freien Freiheitsgrade
+ *  fuer die aktuelle Nummerierung: bandwidth = max(i-j), profile = Summe
+ *  ueber die Zeilen von i - min(j), jeweils ueber die Eintraege a_ij != 0.
+ *
+ */
+void Discretization::dof_envelope(
+    int&                       _bandwidth,           // Bandbreite (o)
+    long&                      _profile              // Profil (o)
+    )
+{
+  Array1D<int> first(num_dof_solve);
+  for (int i=0; i<num_dof_solve; i++)
+    first[i] = i;
+
+  for (int i=0; i < element.get_size(); i++)
+  {
+    Element &act_element = *element[i];
+
+    int min_dof = num_dof_solve;
+    for (int l=0; l<4; l++)
+      for (int k=0; k<2; k++)
+        if ( !act_element.nodes_get(l)->get_bc_displ(k) )
+          min_dof = min(min_dof, act_element.nodes_get(l)->dof_get(k));
+
+    for (int l=0; l<4; l++)
+      for (int k=0; k<2; k++)
+        if ( !act_element.nodes_get(l)->get_bc_displ(k) )
+        {
+          int d = act_element.nodes_get(l)->dof_get(k);
+          first[d] = min(first[d], min_dof);
+        }
+  }
+
+  _bandwidth = 0;
+  _profile   = 0;
+  for (int i=0; i<num_dof_solve; i++)
+  {
+    _bandwidth = max(_bandwidth, i - first[i]);
+    _profile  += i - first[i];
+  }
+
+  return;
+}
+
+
+
+
+/** Einfaerben der Elemente fuer die parallele Assemblierung
+ *  Greedy in Elementreihenfolge: jedes Element erhaelt die kleinste Farbe,
+ *  die kein bereits gefaerbtes Element mit gemeinsamem Knoten hat. Elemente
+ *  einer Farbe haben damit keine gemeinsamen Freiheitsgrade.
+ *
+ */
+void Discretization::color_elements()
+{
+  int num_ele = element.get_size();
+
+  Array1D<int> color(num_ele);
+  Array1D<int> used;                                   // used[c] == e: Farbe c ist fuer Element e belegt
+  color.init(-1);
+  num_colors = 0;
+
+  for (int e=0; e<num_ele; e++)
+  {
+    Element &act_element = *element[e];
+
+    for (int l=0; l<4; l++)
+    {
+      Node &act_node = *act_element.nodes_get(l);
+      for (int j=0; j<act_node.element_get_size(); j++)
+      {
+        int c = color[ act_node.element_get(j)->get_id() ];
+        if (c >= 0)
+          used[c] = e;
+      }
+    }
+
+    int c = 0;
+    while (c < num_colors && used[c] == e)
+      c++;
+
+    if (c == num_colors)
+    {
+      num_colors++;
+      used.resize(num_colors);
+      used[c] = -1;
+    }
+    color[e] = c;
+  }
+
+  // Elemente nach Farben sortieren (Zaehlsortierung, stabil)
+  color_ptr = Array1D<int>(num_colors+1);
+  color_ptr.init();
+  for (int e=0; e<num_ele; e++)
+    color_ptr[ color[e]+1 ]++;
+  for (int c=0; c<num_colors; c++)
+    color_ptr[c+1] += color_ptr[c];
+
+  color_ele = Array1D<int>(max(num_ele, 1));
+  Array1D<int> next(max(num_colors, 1));
+  for (int c=0; c<num_colors; c++)
+    next[c] = color_ptr[c];
+  for (int e=0; e<num_ele; e++)
+    color_ele[ next[color[e]]++ ] = e;
+
+  if (verbose)
+    printf("%6i element colors\n", num_colors);
+
+  return;
+}
+
+
+
+
+/** Zwischenspeicher der Elementsteifigkeitsmatrizen aufbauen
+ *  Kongruente Elemente mit gleichem Material teilen sich eine Matrix, bei
+ *  den Netzen des Generators ist das nur eine fuer alle Elemente. Die
+ *  Koordinaten werden auf 1e-12 der Gebietsgroesse gerundet verglichen.
+ *  Muss nach einer Aenderung von Knoten oder Materialien erneut aufgerufen
+ *  werden.
+ *
+ */
+void Discretization::build_element_cache()
+{
+  ele_cache.build( element, 1e-12*max(l_x, l_y) );
+
+  if (verbose)
+    printf("%6i distinct element matrices\n", ele_cache.get_num_entries());
+
+  return;
+}
+
+
+
+
+/** Zuordnung der Elementbeitraege zu Positionen im Wertevektor einer MSR-Matrix
+ *  Fuer jedes Element und jedes lokale Paar (l,k) wird die Position von
+ *  ele_stiff[l][k] im Wertevektor abgelegt, -1 fuer gehaltene
+ *  Freiheitsgrade. Die Assemblierung kommt damit ohne get_dirich_flag und
+ *  ohne Suche in der Zeile aus. Muss nach jeder Aenderung der
+ *  Besetzungsstruktur neu erstellt werden, assemble_stalin erkennt einen
+ *  Wechsel der Matrix selbst.
+ *
+ */
+void Discretization::build_scatter_map(
+    Matrix_MSR const   *_a                  // Matrix mit fertiger Besetzungsstruktur (i)
+)
+{
+
+  int num_ele = element.get_size();
+
+  scatter_map = Array1D<int>( max(64*num_ele, 1) );
+  int* map = scatter_map.get_dataptr();
+  int  num_missing = 0;
+
+  #pragma omp parallel for schedule(static) reduction(+:num_missing)
+  for (int e=0; e<num_ele; e++)
+  {
+    Element &act_element = *element[e];
+    int*     map_e       = map + 64*e;
+
+    for (int l=0; l<8; l++) //rows
+      for (int k=0; k<8; k++) //columns
+      {
+        if ( act_element.get_dirich_flag(l) || act_element.get_dirich_flag(k) )
+          map_e[8*l+k] = -1;
+        else
+        {
+          int p = _a->get_offset( act_element.idMatrix_get(l), act_element.idMatrix_get(k) );
+          if (p < 0)
+            num_missing++;
+          map_e[8*l+k] = p;
+        }
+      }
+  }
+
+  if (num_missing > 0)
+    throw runtime_error(string("Discretization: entry missing in sparsity pattern!!"));
+
+  scatter_matrix = _a;
+  scatter_nnz    = _a->get_nnz();
+
+  return;
+}
+
+
+
+
 /** lineare globale Steifigkeitsmatrix assemblieren
- * - Berechnung der Elementsteifigkeitsmatrizen
+ * - Elementsteifigkeitsmatrizen aus dem Zwischenspeicher (oder berechnet)
  * - Assemblierung in die globale Matrix
+ * Die Farben werden nacheinander bearbeitet, die Elemente einer Farbe
+ * parallel: sie haben keine gemeinsamen Freiheitsgrade, die Matrix braucht
+ * also keine Sperren. Jeder Eintrag erhaelt seine Beitraege immer in der
+ * Reihenfolge der Farben, das Ergebnis ist unabhaengig von der Anzahl
+ * Threads bitweise gleich.
+ * Fuer MSR-Matrizen wird ueber die scatter_map direkt in den Wertevektor
+ * addiert, sonst ueber add_entry.
  *
  */
 void Discretization::assemble_stalin(
@@ -272,33 +610,71 @@ void Discretization::assemble_stalin(
 )
 {
 
-  Array2D<double>       ele_stiff;          // Elementsteifigkeitsmatrix
-  ele_stiff.resize(8, 8);
+  int const* cp = color_ptr.get_dataptr();
+  int const* ce = color_ele.get_dataptr();
+
+  Matrix_MSR* msr = dynamic_cast<Matrix_MSR*>(_a);
+
+  if ( msr != NULL && (msr != scatter_matrix || msr->get_nnz() != scatter_nnz) )
+    build_scatter_map(msr);
 
+  double*    val = (msr != NULL) ? msr->get_value() : NULL;
+  int const* map = scatter_map.get_dataptr();
 
-  for (int i=0; i< element.get_size(); i++)
+  #pragma omp parallel
   {
-    element[i]->stiffness_lin( ele_stiff );
+    Array2D<double>       ele_stiff;          // Elementsteifigkeitsmatrix
+    ele_stiff.resize(8, 8);
 
-    for (int k=0; k<8; k++) //columns
+    for (int c=0; c<num_colors; c++)
     {
-    	// this column is a constrained dof
-    	if ( element[i]->get_dirich_flag(k) )
-    		continue;
 
-        for (int l=0; l<8; l++) //rows
-          // this row is NOT a constrained dof
-          if ( !element[i]->get_dirich_flag(l) )
-        	  _a->add_entry(
-        			  element[i]->idMatrix_get(l),
-        			  element[i]->idMatrix_get(k),
-        			  ele_stiff[l][k] );
-    }
+      #pragma omp for schedule(static)
+      for (int ii=cp[c]; ii<cp[c+1]; ii++)
+      {
+        int      e           = ce[ii];
+        Element &act_element = *element[e];
 
+        double const* ke;                         // Elementsteifigkeitsmatrix, zeilenweise
+        if ( ele_cache.is_built() )
+          ke = ele_cache.get_stiffness(e);
+        else
+        {
+          act_element.stiffness_lin( ele_stiff );
+          ke = ele_stiff[0];
+        }
+
+        if (msr != NULL)
+        {
+          int const* map_e = map + 64*e;
+          for (int q=0; q<64; q++)
+            if (map_e[q] >= 0)
+              val[ map_e[q] ] += ke[q];
+          continue;
+        }
+
+        for (int k=0; k<8; k++) //columns
+        {
+          // this column is a constrained dof
+          if ( act_element.get_dirich_flag(k) )
+            continue;
+
+          for (int l=0; l<8; l++) //rows
+            // this row is NOT a constrained dof
+            if ( !act_element.get_dirich_flag(l) )
+              _a->add_entry(
+                  act_element.idMatrix_get(l),
+                  act_element.idMatrix_get(k),
+                  ke[8*l+k] );
+        }
+      }
+
+    }
   }
 
   // Flags fuer die Matrix und den Loeser setzen
   _a->set_assembled(true);
+  _a->set_factorized(false);
 
   return;
 }
@@ -306,19 +682,130 @@ void Discretization::assemble_stalin(
 
 
 
+/** lineare globale Steifigkeitsmatrix ohne vorab bestimmte Besetzungsstruktur
+ * Jedes Element schreibt seine Beitraege als (Zeile, Spalte, Wert)-Tripel
+ * in einen eigenen Abschnitt der Tripelliste, die Abschnitte ergeben sich
+ * aus der Anzahl freier Freiheitsgrade je Element. Die Elemente werden
+ * ohne Synchronisation parallel bearbeitet. Sortieren und Aufsummieren der
+ * Tripel erzeugt die Matrix in einem Schritt, fill_dof_connect entfaellt.
+ * Die Abschnitte liegen in der Reihenfolge von color_ele, das stabile
+ * Sortieren summiert gleiche Eintraege daher in derselben Reihenfolge wie
+ * assemble_stalin, die Matrizen stimmen bitweise ueberein.
+ *
+ */
+Matrix_MSR* Discretization::assemble_stalin_triplets()
+{
+
+  int num_ele = element.get_size();
+
+  int const* ce = color_ele.get_dataptr();
+
+  // Abschnitt jedes Elements in der Tripelliste, in der Reihenfolge der
+  // Farben wie in assemble_stalin
+  Array1D<int> offset(num_ele+1);
+  offset[0] = 0;
+  for (int ii=0; ii<num_ele; ii++)
+  {
+    Element &act_element = *element[ce[ii]];
+    int m = 0;
+    for (int k=0; k<8; k++)
+      if ( !act_element.get_dirich_flag(k) )
+        m++;
+    offset[ii+1] = offset[ii] + m*m;
+  }
+
+  Triplet_List triplets(num_dof_solve, offset[num_ele]);
+  int const* op = offset.get_dataptr();
+
+  #pragma omp parallel
+  {
+    Array2D<double>       ele_stiff;          // Elementsteifigkeitsmatrix
+    ele_stiff.resize(8, 8);
+
+    #pragma omp for schedule(static)
+    for (int ii=0; ii<num_ele; ii++)
+    {
+      int      e           = ce[ii];
+      Element &act_element = *element[e];
+
+      double const* ke;                           // Elementsteifigkeitsmatrix, zeilenweise
+      if ( ele_cache.is_built() )
+        ke = ele_cache.get_stiffness(e);
+      else
+      {
+        act_element.stiffness_lin( ele_stiff );
+        ke = ele_stiff[0];
+      }
+
+      int p = op[ii];
+      for (int k=0; k<8; k++) //columns
+      {
+        // this column is a constrained dof
+        if ( act_element.get_dirich_flag(k) )
+          continue;
+
+        for (int l=0; l<8; l++) //rows
+          // this row is NOT a constrained dof
+          if ( !act_element.get_dirich_flag(l) )
+            triplets.set( p++,
+                act_element.idMatrix_get(l),
+                act_element.idMatrix_get(k),
+                ke[8*l+k] );
+      }
+    }
+  }
+
+  return triplets.create_MSR();
+}
+
+
+
+
 
 /** Berechnung der linearen Spannungen
  *  fuer alle Elemente der Diskretisierung
+ *  Die Elemente werden in Bloecken von Scheibe_q1::batch_size parallel mit
+ *  stress_lin_batch bearbeitet, andere Elementtypen einzeln.
  *
  */
 void Discretization::cal_stress_lin()
 {
 
-  // Schleife ueber alle Elemente der Diskretisierung
-  for(int i=0; i < element.get_size(); i++)
+  const int W = Scheibe_q1::batch_size;
+  int num_ele    = element.get_size();
+  int num_blocks = (num_ele + W-1) / W;
+
+  // Schleife ueber alle Bloecke von Elementen
+  #pragma omp parallel
   {
-    // Berechnung der linearen Spannungen
-    element[i]->stress_lin( );
+    double x[4*W], y[4*W], c[9*W], d[8*W], st[12*W];
+
+    #pragma omp for schedule(static)
+    for (int b=0; b<num_blocks; b++)
+    {
+      int  num = min(W, num_ele - b*W);
+      bool soa = true;                                 // alle Elemente des Blocks Scheibe_q1?
+      for (int s=0; s<num; s++)
+        if ( dynamic_cast<Scheibe_q1*>(element[b*W+s]) == NULL )
+          soa = false;
+
+      if (!soa)
+      {
+        for (int s=0; s<num; s++)
+          element[b*W+s]->stress_lin( );
+        continue;
+      }
+
+      // unbenutzte Spuren mit dem letzten Element auffuellen
+      for (int s=0; s<W; s++)
+        ((Scheibe_q1*)element[b*W+min(s,num-1)])->gather_batch(s, x, y, c, d);
+
+      // Berechnung der linearen Spannungen
+      Scheibe_q1::stress_lin_batch(x, y, c, d, st);
+
+      for (int s=0; s<num; s++)
+        ((Scheibe_q1*)element[b*W+s])->scatter_stress(s, st);
+    }
   }
 
   return;
@@ -398,146 +885,102 @@ void Discretization::disp2node_copy(
 
 
 /** Konnektivitaet zwischen den Freiheitsgraden wird ermittelt
- * (Hilfsfunktion fuer  MSR-Matrizen)
+ * (Hilfsfunktion fuer MSR-Matrizen)
+ * Ergebnis ist die Besetzungsstruktur im CSR-Format mit aufsteigend
+ * sortierten Spalten. Die beiden Freiheitsgrade eines Knotens haben
+ * dieselben Nachbarn: fuer jeden Knoten werden die freien Freiheitsgrade
+ * der angrenzenden Elemente (ID-Matrix) gesammelt, sortiert und Duplikate
+ * entfernt. Erst werden die Zeilenlaengen gezaehlt, nach der Praefixsumme
+ * die Spalten geschrieben; beide Durchlaeufe parallel ueber die Knoten.
  *
  */
 void Discretization::fill_dof_connect(
     int&                       _nnz,                 // Anzahl der nicht-Null Eintraege der Matrix (o)
-    Array1D<int>&              _num_dof_connect,     // Anzahl der nicht-Null Eintraege pro Zeile (o)
-    Array1D< List<int> >&      _dof_connect,         // Spalten der nicht-Null Eintraege fuer jede Zeile (o)
-    bool                       _msr                  // Modifikation fuer MSR-Format verwenden (i)
+    Array1D<int>&              _row_ptr,             // Anfang jeder Zeile in col, Laenge num_dof_solve+1 (o)
+    Array1D<int>&              _col,                 // Spalten der nicht-Null Eintraege, zeilenweise (o)
+    bool                       _msr                  // Modifikation fuer MSR-Format verwenden (Diagonale weglassen) (i)
 )
 {
 
-  int                         counter;
-
-  _nnz = 0;
-  _num_dof_connect.resize(num_dof_solve);
-  _dof_connect.resize(num_dof_solve);
-
-
-  /* Alle Zeilen von dof_connect mit der Laenge 20 allokieren und mit -1 initialisieren */
-  for(int i=0; i < num_dof_solve; i++)
-  {
-    _num_dof_connect[i] = 0;
-    _dof_connect[i].resize(20);
-    _dof_connect[i].reset(-1);
-  }
+  int num_node = node.get_size();
 
+  _row_ptr = Array1D<int>(num_dof_solve+1);
 
+  int* rp = _row_ptr.get_dataptr();
+  int* cp = NULL;
 
-  /* Schleife ueber alle Knoten der Diskretisierung */
-  for(int i=0; i < node.get_size(); i++)
+  for (int pass=0; pass<2; pass++)
   {
-    Node &act_node = *node[i];
 
-    /* Schleife ueber alle dofs am Knoten */
-    for (int ii=0; ii<2; ii++)
+    #pragma omp parallel
     {
+      Array1D<int> buf;                              // Spalten eines Knotens, waechst bei Bedarf
 
-      int actdof = act_node.dof_get(ii);
+      #pragma omp for schedule(dynamic, 64)
+      for (int i=0; i<num_node; i++)
+      {
+        Node &act_node = *node[i];
 
+        if ( act_node.get_bc_displ(0) && act_node.get_bc_displ(1) )
+          continue;
 
-      /* skip all dirichlet dofs */
-      if ( act_node.get_bc_displ(ii) )
-        continue;
+        /* freie Freiheitsgrade aller angrenzenden Elemente sammeln */
+        int len = 8 * act_node.element_get_size();
+        if (buf.get_size() < len)
+          buf = Array1D<int>(len);
 
+        int* b = buf.get_dataptr();
+        int  m = 0;
+        for (int j=0; j<act_node.element_get_size(); j++)
+        {
+          Element &act_element = *act_node.element_get(j);
+          for (int k=0; k<8; k++)
+            if ( !act_element.get_dirich_flag(k) )
+              b[m++] = act_element.idMatrix_get(k);
+        }
 
-      /* find all connected dofs */
-      /* loop all adjacent elements */
-      for (int j=0; j<act_node.element_get_size(); j++)
-      {
-        Element &act_element = *act_node.element_get(j);
+        std::sort(b, b+m);
+        m = (int) (std::unique(b, b+m) - b);
 
-        /* loop all nodes of act_element */
-        for (int l = 0; l < 4; l++)
+        for (int ii=0; ii<2; ii++)
         {
+          /* skip all dirichlet dofs */
+          if ( act_node.get_bc_displ(ii) )
+            continue;
 
-          Node &act_node2 = *act_element.nodes_get(l);
-          for (int k=0; k<2; k++)
+          int actdof = act_node.dof_get(ii);
+
+          if (pass == 0)
           {
-            /* dirichlet dofs don't matter in the matrix */
-            if ( act_node2.get_bc_displ(k) )
-              continue;
-            /* write dof in dof_patch */
-            _dof_connect[actdof].append(act_node2.dof_get(k));
-            _num_dof_connect[actdof]++;
+            rp[actdof+1] = _msr ? m-1 : m;
+            continue;
           }
+
+          int c = rp[actdof];
+          for (int l=0; l<m; l++)
+            if ( !_msr || b[l] != actdof )
+              cp[c++] = b[l];
         }
       }
-
     }
-  }
 
-
-  /* Schleife ueber alle Zeilen von dof_connect */
-  for(int i=0; i < num_dof_solve; i++)
-  {
-    /* Schleife ueber alle dofs in der Zeile */
-    for (int j=0; j<_num_dof_connect[i]; j++)
+    if (pass == 0)
     {
-      /* aktuelle Spalte ist leer, d.h. = -1 */
-      if (_dof_connect[i][j] == -1) continue;
-
-
-      /* fuer msr den dof der zeile entfernen */
-      if (_msr)
-        if (_dof_connect[i][j] == i) _dof_connect[i][j] = -1;
-
-
-      /* dof nummer der aktuellen Spalte */
-      int dof = _dof_connect[i][j];
-
-
-      /* in allen anderen Spalten diesen dof loeschen, auf -1 setzen */
-      for (int k=j+1; k<_num_dof_connect[i];k++)
-      {
-        if (dof == _dof_connect[i][k]) _dof_connect[i][k] = -1;
-      }
-    }
-
+      /* Praefixsumme der Zeilenlaengen */
+      rp[0] = 0;
+      for (int i=0; i<num_dof_solve; i++)
+        rp[i+1] += rp[i];
 
-    int n = _num_dof_connect[i];
-    bool vertauscht;
-    /* Bubble sort */
-    do
-    {
-      vertauscht = false;
-      for (int j=0; j<_num_dof_connect[i]-1; j++)
-      {
-        if (_dof_connect[i][j] == -1 || (_dof_connect[i][j+1] != -1 && _dof_connect[i][j] > _dof_connect[i][j+1]))
-        {
-          int tmp             = _dof_connect[i][j+1];
-          _dof_connect[i][j+1] = _dof_connect[i][j];
-          _dof_connect[i][j]   = tmp;
-          vertauscht = true;
-        }
-      }
-      n = n - 1;
+      _col = Array1D<int>(max(rp[num_dof_solve], 1));
+      cp   = _col.get_dataptr();
     }
-    while(vertauscht && n>1);
-
 
-    counter = _num_dof_connect[i];
-    /* count number of dofs in this patch */
-    for (int j=0; j<_num_dof_connect[i]; j++)
-      if (_dof_connect[i][j] == -1)
-      {
-        counter = j;
-        break;
-      }
-
-
-    _num_dof_connect[i] = counter;
-    _dof_connect[i].resize(counter);
-
-
-    if (_msr)
-      counter += 1;
+  }
 
-    _nnz += counter;
 
-  }
+  _nnz = rp[num_dof_solve];
+  if (_msr)
+    _nnz += num_dof_solve;
 
 
   return;
@@ -0,0 +1,444 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Renumbering.h"
+#include <algorithm>
+
+
+/** Breitensuche von start ueber die Knoten v mit mark[v] == id
+ *  level muss fuer diese Knoten -1 sein und wird gesetzt; list enthaelt die
+ *  besuchten Knoten in Besuchsreihenfolge. Rueckgabe ist die Anzahl Level.
+ *  Der Aufrufer setzt level der besuchten Knoten wieder auf -1.
+ *
+ */
+int Renumbering::bfs(
+    int                           _start,              // Startknoten (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    int const*                    _mark,               // Teilmenge je Knoten (i)
+    int                           _id,                 // zu durchsuchende Teilmenge (i)
+    int*                          _level,              // Level je Knoten (i/o)
+    int*                          _list,               // besuchte Knoten (o)
+    int&                          _num                 // Anzahl besuchter Knoten (o)
+    )
+{
+  int depth = 0;
+
+  _num = 0;
+  _list[_num++]   = _start;
+  _level[_start]  = 0;
+
+  for (int h=0; h<_num; h++)
+  {
+    int v = _list[h];
+    for (int k=_ptr[v]; k<_ptr[v+1]; k++)
+    {
+      int w = _adj[k];
+      if (_mark[w] != _id || _level[w] >= 0)
+        continue;
+
+      _level[w]     = _level[v] + 1;
+      depth         = max(depth, _level[w]);
+      _list[_num++] = w;
+    }
+  }
+
+  return depth + 1;
+}
+
+
+
+
+/** Pseudo-peripherer Knoten nach George/Liu
+ *  Ausgehend von start wird wiederholt der Knoten kleinsten Grades im
+ *  letzten Level gewaehlt, solange die Anzahl Level waechst.
+ *
+ */
+int Renumbering::pseudo_peripheral(
+    int                           _start,              // Startknoten (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    int const*                    _mark,               // Teilmenge je Knoten (i)
+    int                           _id,                 // zu durchsuchende Teilmenge (i)
+    int*                          _level,              // Arbeitsfeld, -1 in der Teilmenge (i/o)
+    int*                          _list                // Arbeitsfeld (-)
+    )
+{
+  int num;
+  int s    = _start;
+  int nlev = bfs(s, _ptr, _adj, _mark, _id, _level, _list, num);
+
+  while (true)
+  {
+    int u = -1;
+    for (int k=0; k<num; k++)
+    {
+      int v = _list[k];
+      if (_level[v] == nlev-1 && (u < 0 || _ptr[v+1]-_ptr[v] < _ptr[u+1]-_ptr[u]))
+        u = v;
+    }
+
+    for (int k=0; k<num; k++)
+      _level[_list[k]] = -1;
+
+    int nlev_u = bfs(u, _ptr, _adj, _mark, _id, _level, _list, num);
+    if (nlev_u <= nlev)
+      break;
+
+    s    = u;
+    nlev = nlev_u;
+  }
+
+  for (int k=0; k<num; k++)
+    _level[_list[k]] = -1;
+
+  return s;
+}
+
+
+
+
+/** Reverse Cuthill-McKee
+ *  Je Zusammenhangskomponente Breitensuche ab einem pseudo-peripheren Knoten,
+ *  die Nachbarn eines Knotens nach aufsteigendem Grad; am Ende umgekehrt.
+ *
+ */
+void Renumbering::rcm(
+    int                           _n,                  // Anzahl Knoten (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    Array1D<int>&                 _order               // neue Reihenfolge (o)
+    )
+{
+  _order = Array1D<int>(_n);
+
+  Array1D<int> mark(_n);
+  Array1D<int> level(_n);
+  Array1D<int> list(_n);
+  mark.init(0);
+  level.init(-1);
+
+  int* o   = _order.get_dataptr();
+  int* mk  = mark.get_dataptr();
+  int  pos = 0;
+
+  while (pos < _n)
+  {
+    // Startknoten: kleinster Grad unter den noch nicht nummerierten
+    int s = -1;
+    for (int v=0; v<_n; v++)
+      if (mk[v] == 0 && (s < 0 || _ptr[v+1]-_ptr[v] < _ptr[s+1]-_ptr[s]))
+        s = v;
+
+    s = pseudo_peripheral(s, _ptr, _adj, mk, 0, level.get_dataptr(), list.get_dataptr());
+
+    int head = pos;
+    o[pos++] = s;
+    mk[s]    = 1;
+
+    while (head < pos)
+    {
+      int v  = o[head++];
+      int k0 = pos;
+      for (int k=_ptr[v]; k<_ptr[v+1]; k++)
+      {
+        int w = _adj[k];
+        if (mk[w] != 0)
+          continue;
+        mk[w]    = 1;
+        o[pos++] = w;
+      }
+
+      std::sort(o+k0, o+pos, [_ptr](int a, int b) { return _ptr[a+1]-_ptr[a] < _ptr[b+1]-_ptr[b]; });
+    }
+  }
+
+  std::reverse(o, o+_n);
+
+  return;
+}
+
+
+
+
+/** Rekursive Zerlegung einer Teilmenge fuer die Nested Dissection
+ *  Die Level einer Breitensuche ab einem pseudo-peripheren Knoten werden
+ *  in der Mitte getrennt: vorne, hinten, dann der Separator (mittleres Level).
+ *  Nicht zusammenhaengende Teilmengen werden in Komponenten aufgeteilt.
+ *
+ */
+void Renumbering::dissect(
+    int*                          _set,                // Knoten der Teilmenge, wird umsortiert (i/o)
+    int                           _size,               // Anzahl Knoten der Teilmenge (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    int*                          _mark,               // Teilmenge je Knoten (i/o)
+    int&                          _next_id,            // naechste freie Kennung einer Teilmenge (i/o)
+    int*                          _level,              // Arbeitsfeld, -1 ausserhalb laufender Suchen (i/o)
+    int*                          _list,               // Arbeitsfeld (-)
+    int*                          _order,              // neue Reihenfolge (o)
+    int&                          _pos                 // naechste Position in order (i/o)
+    )
+{
+  if (_size <= 32)
+  {
+    for (int k=0; k<_size; k++)
+      _order[_pos++] = _set[k];
+    return;
+  }
+
+  int id = _next_id++;
+  for (int k=0; k<_size; k++)
+    _mark[_set[k]] = id;
+
+  int s = pseudo_peripheral(_set[0], _ptr, _adj, _mark, id, _level, _list);
+
+  int num;
+  int nlev = bfs(s, _ptr, _adj, _mark, id, _level, _list, num);
+
+  // Teilmenge nach Level sortieren: vorne (< mid), Separator (== mid), hinten (> mid);
+  // nicht erreichte Knoten (andere Komponente) bilden einen eigenen Teil
+  int  mid      = nlev / 2;
+  bool connect  = (num == _size);
+  int  cnt[4]   = { 0, 0, 0, 0 };                      // vorne, hinten, Separator, nicht erreicht
+
+  for (int k=0; k<_size; k++)
+  {
+    int l = _level[_set[k]];
+    int c = (l < 0) ? 3 : (l < mid ? 0 : (l > mid ? 1 : 2));
+    _list[k] = c;
+    cnt[c]++;
+  }
+
+  if (connect && (nlev < 3 || cnt[2] == _size))
+  {
+    for (int k=0; k<num; k++)
+      _level[_set[k]] = -1;
+    for (int k=0; k<_size; k++)
+      _order[_pos++] = _set[k];
+    return;
+  }
+
+  Array1D<int> tmp(_size);
+  int off[4] = { 0, cnt[0], cnt[0]+cnt[1], cnt[0]+cnt[1]+cnt[2] };
+  for (int k=0; k<_size; k++)
+    tmp[ off[_list[k]]++ ] = _set[k];
+  for (int k=0; k<_size; k++)
+  {
+    _set[k]          = tmp[k];
+    _level[_set[k]]  = -1;
+  }
+
+  if (!connect)
+  {
+    // erreichte Komponente und Rest getrennt zerlegen
+    dissect(_set, num, _ptr, _adj, _mark, _next_id, _level, _list, _order, _pos);
+    dissect(_set + num, _size - num, _ptr, _adj, _mark, _next_id, _level, _list, _order, _pos);
+    return;
+  }
+
+  dissect(_set, cnt[0], _ptr, _adj, _mark, _next_id, _level, _list, _order, _pos);
+  dissect(_set + cnt[0], cnt[1], _ptr, _adj, _mark, _next_id, _level, _list, _order, _pos);
+
+  for (int k=cnt[0]+cnt[1]; k<_size; k++)
+    _order[_pos++] = _set[k];
+
+  return;
+}
+
+
+
+
+/** Nested Dissection ueber Level-Separatoren
+ *
+ */
+void Renumbering::nested_dissection(
+    int                           _n,                  // Anzahl Knoten (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    Array1D<int>&                 _order               // neue Reihenfolge (o)
+    )
+{
+  _order = Array1D<int>(_n);
+
+  Array1D<int> set(_n);
+  Array1D<int> mark(_n);
+  Array1D<int> level(_n);
+  Array1D<int> list(_n);
+  mark.init(0);
+  level.init(-1);
+
+  for (int v=0; v<_n; v++)
+    set[v] = v;
+
+  int next_id = 1;
+  int pos     = 0;
+  dissect(set.get_dataptr(), _n, _ptr, _adj, mark.get_dataptr(), next_id,
+      level.get_dataptr(), list.get_dataptr(), _order.get_dataptr(), pos);
+
+  return;
+}
+
+
+
+
+/** Index eines Punkts (x,y) auf der Hilbert-Kurve in einem 2^16 x 2^16 Gitter
+ *
+ */
+static unsigned int hilbert_index(
+    unsigned int                  _x,                  // Gitterkoordinate x (i)
+    unsigned int                  _y                   // Gitterkoordinate y (i)
+    )
+{
+  unsigned int d = 0;
+
+  for (unsigned int s=1u<<15; s>0; s>>=1)
+  {
+    unsigned int rx = (_x & s) > 0;
+    unsigned int ry = (_y & s) > 0;
+    d += s * s * ((3 * rx) ^ ry);
+
+    // Quadrant drehen
+    if (ry == 0)
+    {
+      if (rx == 1)
+      {
+        _x = s-1 - (_x & (s-1));
+        _y = s-1 - (_y & (s-1));
+      }
+      unsigned int t = _x;
+      _x = _y;
+      _y = t;
+    }
+  }
+
+  return d;
+}
+
+
+
+
+/** Sortierung der Knoten entlang einer Hilbert-Kurve durch das umschliessende Rechteck
+ *
+ */
+void Renumbering::hilbert(
+    int                           _n,                  // Anzahl Knoten (i)
+    double const*                 _x,                  // x-Koordinaten (i)
+    double const*                 _y,                  // y-Koordinaten (i)
+    Array1D<int>&                 _order               // neue Reihenfolge (o)
+    )
+{
+  _order = Array1D<int>(_n);
+  if (_n == 0)
+    return;
+
+  double x0 = _x[0], x1 = _x[0], y0 = _y[0], y1 = _y[0];
+  for (int v=1; v<_n; v++)
+  {
+    x0 = min(x0, _x[v]);  x1 = max(x1, _x[v]);
+    y0 = min(y0, _y[v]);  y1 = max(y1, _y[v]);
+  }
+
+  // gleicher Massstab in x und y, damit die Kurve die Geometrie abbildet
+  double scale = 65535.0 / max(max(x1-x0, y1-y0), 1e-300);
+
+  Array1D<unsigned int> key(_n);
+  for (int v=0; v<_n; v++)
+    key[v] = hilbert_index( (unsigned int) ((_x[v]-x0)*scale), (unsigned int) ((_y[v]-y0)*scale) );
+
+  int*                o = _order.get_dataptr();
+  unsigned int const* kp = key.get_dataptr();
+  for (int v=0; v<_n; v++)
+    o[v] = v;
+
+  std::stable_sort(o, o+_n, [kp](int a, int b) { return kp[a] < kp[b]; });
+
+  return;
+}
+
+
+
+
+/** neue Reihenfolge fuer eine Strategie, RENUMBER_NONE liefert 0..n-1
+ *
+ */
+void Renumbering::order(
+    Renumber_Type                 _type,               // Strategie (i)
+    int                           _n,                  // Anzahl Knoten (i)
+    int const*                    _ptr,                // Zeilenanfaenge des Graphen (i)
+    int const*                    _adj,                // Nachbarn (i)
+    double const*                 _x,                  // x-Koordinaten (i)
+    double const*                 _y,                  // y-Koordinaten (i)
+    Array1D<int>&                 _order               // neue Reihenfolge (o)
+    )
+{
+  switch (_type)
+  {
+    case RENUMBER_RCM:
+      rcm(_n, _ptr, _adj, _order);
+      break;
+    case RENUMBER_ND:
+      nested_dissection(_n, _ptr, _adj, _order);
+      break;
+    case RENUMBER_HILBERT:
+      hilbert(_n, _x, _y, _order);
+      break;
+    default:
+      _order = Array1D<int>(_n);
+      for (int v=0; v<_n; v++)
+        _order[v] = v;
+      break;
+  }
+
+  return;
+}
+
+
+
+
+/** Bezeichnung einer Strategie fuer Ausgaben
+ *
+ */
+char const* Renumbering::name(
+    Renumber_Type                 _type                // Strategie (i)
+    )
+{
+  switch (_type)
+  {
+    case RENUMBER_RCM:     return "RCM";
+    case RENUMBER_ND:      return "nested dissection";
+    case RENUMBER_HILBERT: return "Hilbert curve";
+    default:               return "none";
+  }
+}
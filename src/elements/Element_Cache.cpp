@@ -0,0 +1,188 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Element.h"
+#include "Material.h"
+
+
+
+
+/** Signatur eines Elements
+ *  Koordinaten der Knoten 1-3 relativ zu Knoten 0, gerundet auf das Raster
+ *  tol, und die Bitmuster von E-Modul und Querdehnzahl.
+ *
+ */
+void Element_Cache::signature(
+    Element&                      _ele,               // Element (i)
+    double                        _tol,               // Rasterweite fuer die Koordinaten (i)
+    long long*                    _key                // Signatur, Laenge key_len (o)
+    )
+{
+  Node* n0 = _ele.nodes_get(0);
+
+  for (int k=1; k<4; k++)
+  {
+    Node* nk = _ele.nodes_get(k);
+    _key[2*(k-1)  ] = llround( (nk->get_x() - n0->get_x()) / _tol );
+    _key[2*(k-1)+1] = llround( (nk->get_y() - n0->get_y()) / _tol );
+  }
+
+  double e  = _ele.get_material()->get_e();
+  double nu = _ele.get_material()->get_nu();
+  memcpy(&_key[6], &e,  sizeof(double));
+  memcpy(&_key[7], &nu, sizeof(double));
+
+  return;
+}
+
+
+
+
+/** Aufbau des Speichers fuer alle Elemente
+ *  Fuer jedes Element wird die Signatur in der Hash-Tabelle gesucht (FNV-1a,
+ *  lineare Sondierung). Nur fuer das erste Element jeder neuen Signatur
+ *  wird die Matrix berechnet, fuer Scheibe_q1 blockweise mit
+ *  stiffness_lin_batch.
+ *
+ */
+void Element_Cache::build(
+    List<Element*>&               _element,           // Liste aller Elemente (i)
+    double                        _tol                // Rasterweite fuer die Koordinaten (i)
+    )
+{
+  int num_ele = _element.get_size();
+
+  int table_size = 16;
+  while (table_size < 2*num_ele)
+    table_size *= 2;
+
+  table = Array1D<int>(table_size);
+  table.init(-1);
+  ele_entry = Array1D<int>( max(num_ele,1) );
+
+  num_entries = 0;
+  keys        = Array1D<long long>( key_len );
+  Array1D<int> first(1);                               // erstes Element jeder Signatur
+
+  long long key[key_len];
+
+  for (int e=0; e<num_ele; e++)
+  {
+    signature(*_element[e], _tol, key);
+
+    unsigned long long h = 14695981039346656037ULL;
+    for (int i=0; i<key_len; i++)
+    {
+      h ^= (unsigned long long)key[i];
+      h *= 1099511628211ULL;
+    }
+
+    int slot = (int)( h & (table_size-1) );
+    int found = -1;
+    while (table[slot] >= 0)
+    {
+      long long const* k2 = keys.get_dataptr() + key_len*table[slot];
+      if (memcmp(k2, key, sizeof(key)) == 0)
+      {
+        found = table[slot];
+        break;
+      }
+      slot = (slot+1) & (table_size-1);
+    }
+
+    if (found < 0)
+    {
+      found = num_entries++;
+      table[slot] = found;
+
+      if (num_entries > first.get_size())
+      {
+        keys.resize( 2*keys.get_size() );
+        first.resize( 2*first.get_size() );
+      }
+
+      memcpy(keys.get_dataptr() + key_len*found, key, sizeof(key));
+      first[found] = e;
+    }
+
+    ele_entry[e] = found;
+  }
+
+
+  // Matrizen der ersten Elemente berechnen
+  matrices = Array1D<double>( mat_len*max(num_entries,1) );
+  double* mat = matrices.get_dataptr();
+
+  const int W = Scheibe_q1::batch_size;
+  int num_blocks = (num_entries + W-1) / W;
+
+  #pragma omp parallel
+  {
+    double x[4*W], y[4*W], c[9*W], ke[64*W];
+    Array2D<double> ele_stiff(8,8);
+
+    #pragma omp for schedule(static)
+    for (int b=0; b<num_blocks; b++)
+    {
+      int  num  = min(W, num_entries - b*W);
+      bool soa  = true;                                // alle Elemente des Blocks Scheibe_q1?
+      for (int s=0; s<num; s++)
+        if ( dynamic_cast<Scheibe_q1*>(_element[ first[b*W+s] ]) == NULL )
+          soa = false;
+
+      if (soa)
+      {
+        // unbenutzte Spuren mit dem letzten Element auffuellen
+        for (int s=0; s<W; s++)
+          ((Scheibe_q1*)_element[ first[b*W+min(s,num-1)] ])->gather_batch(s, x, y, c, NULL);
+
+        Scheibe_q1::stiffness_lin_batch(x, y, c, ke);
+
+        for (int s=0; s<num; s++)
+          for (int q=0; q<mat_len; q++)
+            mat[mat_len*(b*W+s)+q] = ke[q*W+s];
+      }
+      else
+        for (int s=0; s<num; s++)
+        {
+          _element[ first[b*W+s] ]->stiffness_lin( ele_stiff );
+          for (int l=0; l<8; l++)
+            for (int k=0; k<8; k++)
+              mat[mat_len*(b*W+s)+8*l+k] = ele_stiff[l][k];
+        }
+    }
+  }
+
+  return;
+}
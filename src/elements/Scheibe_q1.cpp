@@ -299,3 +299,249 @@ void Scheibe_q1::stress_lin()
 
 
 
+
+
+
+
+/** Koordinaten, Materialmatrix und Verschiebungen in einen Block kopieren
+ *  Der Block ist spurweise (SoA) abgelegt: Wert i der Spur lane steht an
+ *  Position i*batch_size+lane. x,y: 4 Knoten, c: 3x3 zeilenweise,
+ *  d: 8 Verschiebungen (nur falls d != NULL).
+ *
+ */
+void Scheibe_q1::gather_batch(
+    int                           _lane,               // Spur im Block (i)
+    double*                       _x,                  // x-Koordinaten der Knoten (o)
+    double*                       _y,                  // y-Koordinaten der Knoten (o)
+    double*                       _c,                  // Materialmatrix (o)
+    double*                       _d                   // Verschiebungen oder NULL (o)
+)
+{
+  const int W = batch_size;
+
+  for (int k=0; k<4; k++)
+  {
+    _x[k*W+_lane] = nodes[k]->get_x();
+    _y[k*W+_lane] = nodes[k]->get_y();
+  }
+
+  Array2D<double> c(3,3);
+  material->mat2D_lin(c);
+  for (int i=0; i<3; i++)
+    for (int j=0; j<3; j++)
+      _c[(3*i+j)*W+_lane] = c[i][j];
+
+  if (_d != NULL)
+    for (int k=0; k<4; k++)
+    {
+      _d[(2*k  )*W+_lane] = nodes[k]->get_sol(0);
+      _d[(2*k+1)*W+_lane] = nodes[k]->get_sol(1);
+    }
+
+  return;
+}
+
+
+
+
+/** Spannungen einer Spur aus einem Block uebernehmen
+ *
+ */
+void Scheibe_q1::scatter_stress(
+    int                           _lane,               // Spur im Block (i)
+    double const*                 _stress              // Spannungen des Blocks, 4 GP x 3 (i)
+)
+{
+  const int W = batch_size;
+
+  for (int gp=0; gp<4; gp++)
+    for (int i=0; i<3; i++)
+      stress[gp][i] = _stress[(3*gp+i)*W+_lane];
+
+  return;
+}
+
+
+
+
+/** Jacobi-Determinante und Ableitungen der Formfunktionen nach x und y
+ *  an einem Gausspunkt fuer alle Spuren eines Blocks
+ *
+ */
+static void shape_batch(
+    double                        _xi,                 // Gausspunkt xi (i)
+    double                        _eta,                // Gausspunkt eta (i)
+    double const*                 _x,                  // x-Koordinaten der Knoten (i)
+    double const*                 _y,                  // y-Koordinaten der Knoten (i)
+    double*                       _det,                // Jacobi-Determinante (o)
+    double*                       _bx,                 // dN/dx, 4 Knoten (o)
+    double*                       _by                  // dN/dy, 4 Knoten (o)
+)
+{
+  const int W = Scheibe_q1::batch_size;
+
+  // Ableitungen der Formfunctionen (fuer alle Spuren gleich)
+  const double q14 = 1.0/4.0;
+  double rp = 1.0+_xi;
+  double rm = 1.0-_xi;
+  double sp = 1.0+_eta;
+  double sm = 1.0-_eta;
+
+  double deriv[4][2] = { {-q14*sm, -q14*rm},
+                         { q14*sm, -q14*rp},
+                         { q14*sp,  q14*rp},
+                         {-q14*sp,  q14*rm} };
+
+  #pragma omp simd
+  for (int s=0; s<W; s++)
+  {
+    double j00 = 0.0, j01 = 0.0, j10 = 0.0, j11 = 0.0;
+    for (int k=0; k<4; k++)
+    {
+      j00 += deriv[k][0] * _x[k*W+s];
+      j01 += deriv[k][0] * _y[k*W+s];
+      j10 += deriv[k][1] * _x[k*W+s];
+      j11 += deriv[k][1] * _y[k*W+s];
+    }
+    double det = j00*j11 - j10*j01;
+
+    double dum = 1.0/det;
+    double i00 = j11*dum;
+    double i01 =-j01*dum;
+    double i10 =-j10*dum;
+    double i11 = j00*dum;
+
+    _det[s] = det;
+    for (int k=0; k<4; k++)
+    {
+      _bx[k*W+s] = i00*deriv[k][0] + i01*deriv[k][1];
+      _by[k*W+s] = i10*deriv[k][0] + i11*deriv[k][1];
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** lineare Steifigkeitsmatrix fuer einen Block von batch_size Elementen
+ *  Jede Spur rechnet ein Element, die innerste Schleife laeuft ueber die
+ *  Spuren und wird vektorisiert. Die Besetzung des B-Operators wird
+ *  ausgenutzt, die Summationsreihenfolge entspricht stiffness_lin.
+ *  Alle Spuren werden gerechnet, unbenutzte Spuren muessen gueltige
+ *  Koordinaten enthalten. ke: 8x8 zeilenweise, Eintrag q an q*batch_size+lane.
+ *
+ */
+void Scheibe_q1::stiffness_lin_batch(
+    double const*                 _x,                  // x-Koordinaten der Knoten (i)
+    double const*                 _y,                  // y-Koordinaten der Knoten (i)
+    double const*                 _c,                  // Materialmatrix (i)
+    double*                       _ke                  // Elementsteifigkeitsmatrizen (o)
+)
+{
+  const int W = batch_size;
+
+  double det[W];
+  double bx[4*W];
+  double by[4*W];
+  double t[8][3][W];                                   // t = w*det * B^T * C
+
+  for (int q=0; q<64*W; q++)
+    _ke[q] = 0.0;
+
+  const double gp[2] = { -1.0/sqrt(3), +1.0/sqrt(3) };
+
+  for (int j=0; j<2; j++)
+    for (int l=0; l<2; l++)
+    {
+      shape_batch(gp[l], gp[j], _x, _y, det, bx, by);
+
+      // t = (w*det*B^T) * C, B^T hat je Zeile zwei Eintraege ungleich Null
+      for (int m=0; m<4; m++)
+        for (int r=0; r<3; r++)
+        {
+          #pragma omp simd
+          for (int s=0; s<W; s++)
+          {
+            double wd = det[s];                        // Gewicht der Gausspunkte 1.0
+            double sx = wd*bx[m*W+s];
+            double sy = wd*by[m*W+s];
+            t[2*m  ][r][s] = sx*_c[(0*3+r)*W+s] + sy*_c[(2*3+r)*W+s];
+            t[2*m+1][r][s] = sy*_c[(1*3+r)*W+s] + sx*_c[(2*3+r)*W+s];
+          }
+        }
+
+      // ke += t * B
+      for (int a=0; a<8; a++)
+        for (int m=0; m<4; m++)
+        {
+          double* ke0 = _ke + (8*a+2*m  )*W;
+          double* ke1 = _ke + (8*a+2*m+1)*W;
+
+          #pragma omp simd
+          for (int s=0; s<W; s++)
+          {
+            ke0[s] += t[a][0][s]*bx[m*W+s] + t[a][2][s]*by[m*W+s];
+            ke1[s] += t[a][1][s]*by[m*W+s] + t[a][2][s]*bx[m*W+s];
+          }
+        }
+    }
+
+  return;
+}
+
+
+
+
+/** lineare Spannungen an den 4 Gausspunkten fuer einen Block von Elementen
+ *  Aufbau wie stiffness_lin_batch, stress: Komponente i am Gausspunkt gp
+ *  an (3*gp+i)*batch_size+lane.
+ *
+ */
+void Scheibe_q1::stress_lin_batch(
+    double const*                 _x,                  // x-Koordinaten der Knoten (i)
+    double const*                 _y,                  // y-Koordinaten der Knoten (i)
+    double const*                 _c,                  // Materialmatrix (i)
+    double const*                 _d,                  // Verschiebungen (i)
+    double*                       _stress              // Spannungen (o)
+)
+{
+  const int W = batch_size;
+
+  double det[W];
+  double bx[4*W];
+  double by[4*W];
+
+  const double gp[2] = { -1.0/sqrt(3), +1.0/sqrt(3) };
+
+  int count = 0;
+  for (int j=0; j<2; j++)
+    for (int l=0; l<2; l++)
+    {
+      shape_batch(gp[l], gp[j], _x, _y, det, bx, by);
+
+      // stress = (C*B) * d
+      for (int i=0; i<3; i++)
+      {
+        double* st = _stress + (3*count+i)*W;
+
+        #pragma omp simd
+        for (int s=0; s<W; s++)
+        {
+          double sum = 0.0;
+          for (int m=0; m<4; m++)
+          {
+            double cb0 = _c[(3*i+0)*W+s]*bx[m*W+s] + _c[(3*i+2)*W+s]*by[m*W+s];
+            double cb1 = _c[(3*i+1)*W+s]*by[m*W+s] + _c[(3*i+2)*W+s]*bx[m*W+s];
+            sum += cb0*_d[(2*m)*W+s];
+            sum += cb1*_d[(2*m+1)*W+s];
+          }
+          st[s] = sum;
+        }
+      }
+      count++;
+    }
+
+  return;
+}
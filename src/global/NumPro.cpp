@@ -43,6 +43,7 @@ NumPro :: NumPro()
 
   // Diskretisierung wird angelegt
   discretization = new Discretization();
+  //discretization = new Discretization(10, 1, 10, 4, true, RENUMBER_RCM);
 
 
 
@@ -53,9 +54,32 @@ NumPro :: NumPro()
    ************************************/
   stiffness_matrix = new Matrix_MSR( discretization );
   //stiffness_matrix = new Matrix_Dense( discretization );
+  //stiffness_matrix = NULL;                            // Matrix_MSR aus Tripeln, ohne fill_dof_connect
   //solver           = new Solver_LU();
-  //solver           = new Solver_GS();
+  //solver           = new Solver_Cholesky();
+  //solver           = new Solver_Refinement( new Solver_FloatCholesky() );
+  //solver           = new Solver_Refinement( new Solver_FloatCG(1e-3) );
+  //solver           = new Solver_GS(-1.0, false, 1e-8, 100000);
+  //solver           = new Solver_MultiColorGS(1.9, 1e-8, 100000);
   solver           = new Solver_CG(1e-8, 10000);
+  //solver           = new Solver_PipeCG(1e-8, 10000);
+  //solver           = new Solver_BlockCG(1e-8, 10000);
+  //solver           = new Solver_RecycleCG(1e-8, 10000);
+  //solver           = new Solver_Chebyshev(1e-8, 10000);
+
+  // Vorkonditionierer fuer Solver_CG (Standard: Jacobi)
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_SSOR(1.2) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_BlockJacobi(discretization) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_IC() );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_IC(1e-3, 10) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_AMG(discretization) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_GMG(discretization) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_Chebyshev(4) );
+  //((Solver_CG*)solver)->set_precond( new Preconditioner_Schwarz(discretization) );
+
+  // automatische Wahl von Matrixformat, Loeser und Vorkonditionierer nach der
+  // Assemblierung, ersetzt die Wahl oben (Matrix muss Matrix_MSR sein)
+  bool autotune = false;
 
 
 
@@ -74,18 +98,62 @@ NumPro :: NumPro()
 
 
   // lineare Steifigkeitsmatrix und der Vektor der Dirichlet-Kraefte werden assembliert
-  discretization->assemble_stalin(stiffness_matrix);
+  if (stiffness_matrix == NULL)
+    stiffness_matrix = discretization->assemble_stalin_triplets();
+  else
+    discretization->assemble_stalin(stiffness_matrix);
 
 
   // Vektor der aeusseren Kraefte wird assembliert
   discretization->assemble_fext(fext);
 
 
-  // das globale LGS wird geloest */
-  solver->solve(*stiffness_matrix, sol, fext);
+  // Autotuner: Cache, Heuristik oder Probeloesungen
+  Preconditioner* precond = NULL;
+  if (autotune)
+  {
+    Autotuner tuner(discretization);
+    tuner.select(stiffness_matrix, solver, precond, fext);
+  }
+
+
+  // Verlauf des Loesers aufzeichnen (Zeiten, Residuen je Iteration)
+  Solver_Telemetry telemetry;
+  solver->set_telemetry(&telemetry);
 
-  fext.print("f:");
-  sol.print("u:");
+
+  // der Loeser wird fuer die Steifigkeitsmatrix vorbereitet (Faktorisierung)
+  solver->factorize(*stiffness_matrix);
+
+
+  // das globale LGS wird geloest */
+  // Laststeigerung in num_steps gleichen Schritten; die Startwerte der
+  // iterativen Loeser kommen aus dem Verlauf der bisherigen Loesungen
+  int num_steps = 1;
+  Solution_History history(4);
+  Array1D<double> f_step(fext.get_size());
+
+  for (int step=1; step<=num_steps; step++)
+  {
+    double fac = (double) step / num_steps;
+    for (int i=0; i<fext.get_size(); i++)
+      f_step[i] = fac * fext[i];
+
+    history.guess(GUESS_PROJECTION, *stiffness_matrix, f_step, sol);
+    //history.guess(GUESS_EXTRAPOLATE, *stiffness_matrix, f_step, sol);
+    solver->solve(sol, f_step);
+    history.add(sol);
+
+    telemetry.print_summary();
+  }
+  //telemetry.write_csv("numpro_solver.csv");
+  //telemetry.write_json("numpro_solver.json");
+  solver->set_telemetry(NULL);
+
+  // der Vorkonditionierer des Autotuners wird nach dem Loeser freigegeben
+  delete solver;
+  solver = NULL;
+  delete precond;
 
   // die Werte des globalen Loesungsvektors sol werden an die Knoten verteilt
   discretization->disp2node_copy(sol);
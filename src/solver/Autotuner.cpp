@@ -0,0 +1,611 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+#include "Discretization.h"
+#include <sstream>
+
+
+static char const* format_names[]  = { "msr", "dense" };
+static char const* solver_names[]  = { "cholesky", "lu", "gs", "cg" };
+static char const* precond_names[] = { "none", "jacobi", "ssor", "ic", "amg", "gmg" };
+
+
+
+
+/** Abbruch einer Probeloesung, sobald die Zeitschranke ueberschritten ist
+ *  Wird von der Telemetrie nach jeder Iteration aufgerufen, data zeigt auf
+ *  den spaetesten erlaubten Zeitpunkt.
+ *
+ */
+static void trial_deadline(
+    Telemetry_Record const&       /* _rec */,          // gemeldete Iteration (i)
+    void*                         _data                // Zeiger auf die Zeitschranke (i)
+    )
+{
+  if (Solver_Telemetry::wtime() > *(double*)_data)
+    throw runtime_error(string("Autotuner: time budget exceeded!!"));
+  return;
+}
+
+
+
+
+/** Bestimmung der Kenngroessen einer Matrix_MSR
+ *  Bandbreite und Symmetrie werden aus den Nebendiagonal-Eintraegen bestimmt
+ *  (symmetrisch: |a_ij - a_ji| <= 1e-10 * sqrt(|a_ii*a_jj|)),
+ *  der Hash ueber Zeilenanfaenge und Spaltennummern.
+ *
+ */
+void Autotuner::analyze(
+    Matrix const&                 _a                   // assemblierte Matrix (i)
+    )
+{
+  Matrix_MSR const* msr = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (msr == NULL)
+    throw runtime_error(string("Autotuner: only implemented for Matrix_MSR!!"));
+
+  int           n     = msr->get_size();
+  int const*    index = msr->get_index();
+  double const* value = msr->get_value();
+
+  int  bw  = 0;
+  bool sym = true;
+
+  #pragma omp parallel for reduction(max:bw) reduction(&&:sym) schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    for (int k=index[i]; k<index[i+1]; k++)
+    {
+      int j = index[k];
+      bw = max(bw, abs(i-j));
+
+      double a_ij = value[k];
+      double a_ji = msr->get_entry(j, i);
+      // Ausloeschung bei der Assemblierung: Schranke relativ zur Diagonalen
+      if (fabs(a_ij - a_ji) > 1e-10 * sqrt(fabs(value[i]*value[j])))
+        sym = false;
+    }
+  }
+
+  // FNV-1a
+  unsigned int hash = 2166136261u;
+  for (int k=0; k<index[n]; k++)
+  {
+    hash ^= (unsigned int) index[k];
+    hash *= 16777619u;
+  }
+
+  props.num_eq       = n;
+  props.nnz          = msr->get_nnz();
+  props.bandwidth    = bw;
+  props.symmetric    = sym;
+  props.pattern_hash = hash;
+
+  return;
+}
+
+
+
+
+/** Signatur der zuletzt analysierten Matrix (Schluessel im Cache)
+ *
+ */
+string Autotuner::signature() const
+{
+  ostringstream s;
+  s << "n=" << props.num_eq << " nnz=" << props.nnz << " bw=" << props.bandwidth
+    << " sym=" << (props.symmetric ? 1 : 0) << " hash=" << hex << props.pattern_hash;
+  return s.str();
+}
+
+
+
+
+/** Wahl ohne Probeloesungen
+ *  Der Aufwand der dichten Faktorisierung (n^3/3 bzw. 2n^3/3) wird mit dem
+ *  eines CG-Verfahrens verglichen, dessen Iterationszahl bei FE-Netzen
+ *  etwa mit der Bandbreite waechst (Aufwand ~ 50 * nnz * Bandbreite).
+ *  Unsymmetrische Matrizen: LU solange dicht gespeichert werden kann, sonst GS.
+ *
+ */
+Autotune_Choice Autotuner::heuristic() const
+{
+  Autotune_Choice c;
+
+  double n      = props.num_eq;
+  double direct = n*n*n / (props.symmetric ? 3.0 : 1.5);
+  double iter   = 50.0 * props.nnz * max(props.bandwidth, 1);
+
+  if (props.num_eq <= dense_limit && (direct < iter || !props.symmetric))
+  {
+    c.format  = FORMAT_DENSE;
+    c.solver  = props.symmetric ? KIND_CHOLESKY : KIND_LU;
+    c.precond = PRECOND_NONE;
+  }
+  else if (!props.symmetric)
+  {
+    c.format  = FORMAT_MSR;
+    c.solver  = KIND_GS;
+    c.precond = PRECOND_NONE;
+  }
+  else
+  {
+    // AMG fuer grosse oder dicht besetzte Probleme, sonst unvollstaendiges Cholesky
+    double nnz_row = (double) props.nnz / props.num_eq;
+
+    c.format  = FORMAT_MSR;
+    c.solver  = KIND_CG;
+    c.precond = (props.num_eq >= 20000 || nnz_row > 40.0) ? PRECOND_AMG : PRECOND_IC;
+  }
+
+  return c;
+}
+
+
+
+
+/** Liste der Kombinationen fuer die Probeloesungen, die Heuristik zuerst
+ *
+ */
+void Autotuner::candidates(
+    Array1D<Autotune_Choice>&     _list,               // Kombinationen (o)
+    int&                          _num                 // Anzahl Kombinationen (o)
+    ) const
+{
+  _list = Array1D<Autotune_Choice>(12);
+  _num  = 0;
+
+  Autotune_Choice c;
+  bool dense = props.num_eq <= dense_limit;
+
+  _list[_num++] = heuristic();
+
+  c.precond = PRECOND_NONE;
+  c.solver  = props.symmetric ? KIND_CHOLESKY : KIND_LU;
+  if (dense)
+  {
+    c.format = FORMAT_DENSE;  _list[_num++] = c;
+    c.format = FORMAT_MSR;    _list[_num++] = c;
+  }
+
+  c.format = FORMAT_MSR;
+  c.solver = KIND_GS;
+  _list[_num++] = c;
+
+  if (props.symmetric)
+  {
+    c.solver = KIND_CG;
+    c.precond = PRECOND_JACOBI;  _list[_num++] = c;
+    c.precond = PRECOND_SSOR;    _list[_num++] = c;
+    c.precond = PRECOND_IC;      _list[_num++] = c;
+    c.precond = PRECOND_AMG;     _list[_num++] = c;
+    c.precond = PRECOND_GMG;     _list[_num++] = c;
+
+    if (dense)
+    {
+      c.format  = FORMAT_DENSE;
+      c.precond = PRECOND_JACOBI;  _list[_num++] = c;
+    }
+  }
+
+  // Heuristik nicht doppelt probieren
+  for (int k=1; k<_num; k++)
+  {
+    if (_list[k].format == _list[0].format && _list[k].solver == _list[0].solver
+        && _list[k].precond == _list[0].precond)
+    {
+      for (int l=k+1; l<_num; l++)
+        _list[l-1] = _list[l];
+      _num--;
+      break;
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** Vorab-Pruefung einer Kombination, bevor Zeit in factorize fliesst
+ *  Direkte Loeser und Matrix_Dense nur bis dense_limit Gleichungen und nur,
+ *  wenn die Zerlegung (n^3/3 bzw. 2n^3/3 Flop bei dense_rate) in die
+ *  Zeitschranke passt; GMG nur, wenn die Unterteilungen bis zum Grobgitter
+ *  vergroebert werden koennen.
+ *
+ */
+bool Autotuner::feasible(
+    Autotune_Choice const&        _choice,             // zu pruefende Kombination (i)
+    double                        _budget              // Zeitschranke [s] (i)
+    ) const
+{
+  bool direct = (_choice.solver == KIND_CHOLESKY || _choice.solver == KIND_LU);
+
+  if (direct || _choice.format == FORMAT_DENSE)
+  {
+    if (props.num_eq > dense_limit)
+    {
+      printf("  %-20s: skipped (more than %d equations)\n", to_string(_choice).c_str(), dense_limit);
+      return false;
+    }
+
+    double n     = props.num_eq;
+    double flops = n*n*n / (_choice.solver == KIND_LU ? 1.5 : 3.0);
+    if (direct && flops / dense_rate > _budget)
+    {
+      printf("  %-20s: skipped (predicted factorization exceeds time budget)\n", to_string(_choice).c_str());
+      return false;
+    }
+  }
+
+  if (_choice.precond == PRECOND_GMG && !Preconditioner_GMG(dis).coarsens())
+  {
+    printf("  %-20s: skipped (mesh does not coarsen)\n", to_string(_choice).c_str());
+    return false;
+  }
+
+  return true;
+}
+
+
+
+
+/** Probeloesung mit einer Kombination
+ *  Gemessen wird Assemblierung (nur Matrix_Dense), factorize und solve.
+ *  Rueckgabe ist die Zeit in Sekunden oder -1, falls die Kombination
+ *  fehlschlaegt oder die Zeitschranke ueberschreitet. Die Schranke wird
+ *  nach jeder Iteration und zwischen den Phasen geprueft.
+ *
+ */
+double Autotuner::trial(
+    Autotune_Choice const&        _choice,             // zu pruefende Kombination (i)
+    Matrix_MSR&                   _a,                  // assemblierte Matrix (i)
+    Array1D<double>&              _f,                  // rechte Seite (i)
+    double                        _budget              // Zeitschranke [s] (i)
+    ) const
+{
+  double t0       = Solver_Telemetry::wtime();
+  double deadline = t0 + _budget;
+  double time     = -1.0;
+
+  Matrix*         a      = &_a;
+  Matrix*         dense  = NULL;
+  Preconditioner* precond = NULL;
+  Solver*         solver  = NULL;
+
+  Solver_Telemetry telemetry;
+  telemetry.set_callback(trial_deadline, &deadline);
+
+  Array1D<double> u(_a.get_size());
+  u.init();
+
+  try
+  {
+    if (_choice.format == FORMAT_DENSE)
+    {
+      dense = new Matrix_Dense(dis);
+      dis->assemble_stalin(dense);
+      a = dense;
+    }
+
+    solver = create_solver(_choice, precond);
+    solver->set_telemetry(&telemetry);
+    solver->factorize(*a);
+
+    if (Solver_Telemetry::wtime() > deadline)
+      throw runtime_error(string("Autotuner: time budget exceeded!!"));
+
+    solver->solve(u, _f);
+
+    time = Solver_Telemetry::wtime() - t0;
+    if (time > _budget)
+      throw runtime_error(string("Autotuner: time budget exceeded!!"));
+
+    printf("  %-20s: %10.4f s\n", to_string(_choice).c_str(), time);
+  }
+  catch (runtime_error& e)
+  {
+    time = -1.0;
+    printf("  %-20s: failed (%s)\n", to_string(_choice).c_str(), e.what());
+  }
+
+  delete solver;
+  delete precond;
+  delete dense;
+
+  return time;
+}
+
+
+
+
+/** Wahl der Kombination fuer die assemblierte Matrix a
+ *  Reihenfolge: Cache, dann Probeloesungen bzw. Heuristik. Das Ergebnis
+ *  wird in die Cache-Datei eingetragen.
+ *
+ */
+Autotune_Choice Autotuner::tune(
+    Matrix&                       _a,                  // assemblierte Matrix_MSR (i)
+    Array1D<double>&              _f                   // rechte Seite (i)
+    )
+{
+  analyze(_a);
+
+  printf("Autotuner: %d equations, %.1f nnz/row, bandwidth %d, %s\n",
+      props.num_eq, (double) props.nnz / props.num_eq, props.bandwidth,
+      props.symmetric ? "symmetric" : "unsymmetric");
+
+  Autotune_Choice best;
+
+  if (read_cache(best))
+  {
+    printf("Autotuner: %s (cache)\n", to_string(best).c_str());
+    return best;
+  }
+
+  best = heuristic();
+
+  if (trials)
+  {
+    Array1D<Autotune_Choice> list;
+    int num;
+    candidates(list, num);
+
+    double best_time = -1.0;
+    for (int k=0; k<num; k++)
+    {
+      // bis zur ersten erfolgreichen Probe gilt trial_limit, danach die bisher schnellste
+      double budget = (best_time < 0.0) ? trial_limit : best_time;
+      if (!feasible(list[k], budget))
+        continue;
+
+      double time = trial(list[k], dynamic_cast<Matrix_MSR&>(_a), _f, budget);
+
+      // 10% Vorsprung noetig, damit Messrauschen die Wahl nicht umwirft
+      if (time >= 0.0 && (best_time < 0.0 || time < 0.9*best_time))
+      {
+        best      = list[k];
+        best_time = time;
+      }
+    }
+
+    printf("Autotuner: %s (trials)\n", to_string(best).c_str());
+  }
+  else
+    printf("Autotuner: %s (heuristic)\n", to_string(best).c_str());
+
+  write_cache(best);
+
+  return best;
+}
+
+
+
+
+/** Erzeugen des Loesers (und ggf. Vorkonditionierers) fuer eine Kombination
+ *  Der Vorkonditionierer muss vom Aufrufer nach dem Loeser geloescht werden.
+ *
+ */
+Solver* Autotuner::create_solver(
+    Autotune_Choice const&        _choice,             // Kombination (i)
+    Preconditioner*&              _precond             // erzeugter Vorkonditionierer oder NULL (o)
+    ) const
+{
+  _precond = NULL;
+
+  switch (_choice.solver)
+  {
+    case KIND_CHOLESKY:
+      return new Solver_Cholesky();
+
+    case KIND_LU:
+      return new Solver_LU();
+
+    case KIND_GS:
+      return new Solver_GS(-1.0, false, tol_ite, max_ite);
+
+    case KIND_CG:
+      break;
+  }
+
+  switch (_choice.precond)
+  {
+    case PRECOND_SSOR:
+      _precond = new Preconditioner_SSOR(1.2);
+      break;
+    case PRECOND_IC:
+      _precond = new Preconditioner_IC();
+      break;
+    case PRECOND_AMG:
+      _precond = new Preconditioner_AMG(dis);
+      break;
+    case PRECOND_GMG:
+      _precond = new Preconditioner_GMG(dis);
+      break;
+    default:
+      break;
+  }
+
+  Solver_CG* cg = new Solver_CG(tol_ite, max_ite);
+  cg->set_precond(_precond);
+
+  return cg;
+}
+
+
+
+
+/** Automatische Wahl fuer NumPro
+ *  a muss eine assemblierte Matrix_MSR sein. Faellt die Wahl auf
+ *  Matrix_Dense, wird a ersetzt und neu assembliert; der bisherige Loeser
+ *  wird durch den gewaehlten ersetzt. Der dazu erzeugte Vorkonditionierer
+ *  geht an den Aufrufer und ist nach dem Loeser freizugeben.
+ *
+ */
+void Autotuner::select(
+    Matrix*&                      _a,                  // Steifigkeitsmatrix (i/o)
+    Solver*&                      _solver,             // Loeser (i/o)
+    Preconditioner*&              _precond,            // erzeugter Vorkonditionierer oder NULL (o)
+    Array1D<double>&              _f                   // rechte Seite (i)
+    )
+{
+  Autotune_Choice choice = tune(*_a, _f);
+
+  if (choice.format == FORMAT_DENSE)
+  {
+    delete _a;
+    _a = new Matrix_Dense(dis);
+    dis->assemble_stalin(_a);
+  }
+
+  delete _solver;
+  _solver = create_solver(choice, _precond);
+
+  return;
+}
+
+
+
+
+/** Lesen der Cache-Datei
+ *  Zeilen der Form "<signatur> : <format>/<loeser>/<vorkonditionierer>",
+ *  bei mehreren Eintraegen zur selben Signatur gilt der letzte.
+ *
+ */
+bool Autotuner::read_cache(
+    Autotune_Choice&              _choice              // gespeicherte Wahl (o)
+    ) const
+{
+  if (cache_file.empty())
+    return false;
+
+  ifstream in(cache_file.c_str());
+  if (!in)
+    return false;
+
+  string key   = signature();
+  bool   found = false;
+  string line;
+
+  while (getline(in, line))
+  {
+    size_t sep = line.find(" : ");
+    if (sep == string::npos || line.compare(0, sep, key) != 0 || sep != key.size())
+      continue;
+
+    Autotune_Choice c;
+    if (from_string(line.substr(sep+3), c))
+    {
+      _choice = c;
+      found   = true;
+    }
+  }
+
+  return found;
+}
+
+
+
+
+/** Anhaengen der Wahl an die Cache-Datei
+ *
+ */
+void Autotuner::write_cache(
+    Autotune_Choice const&        _choice              // Wahl fuer die aktuelle Signatur (i)
+    ) const
+{
+  if (cache_file.empty())
+    return;
+
+  ofstream out(cache_file.c_str(), ios::app);
+  if (!out)
+  {
+    cerr << "Autotuner: cannot write " << cache_file << endl;
+    return;
+  }
+
+  out << signature() << " : " << to_string(_choice) << endl;
+
+  return;
+}
+
+
+
+
+/** Textdarstellung "<format>/<loeser>/<vorkonditionierer>"
+ *
+ */
+string Autotuner::to_string(
+    Autotune_Choice const&        _choice              // Kombination (i)
+    )
+{
+  return string(format_names[_choice.format]) + "/" + solver_names[_choice.solver]
+    + "/" + precond_names[_choice.precond];
+}
+
+
+
+
+/** Umkehrung von to_string, false bei unbekannten Namen
+ *
+ */
+bool Autotuner::from_string(
+    string const&                 _str,                // Textdarstellung (i)
+    Autotune_Choice&              _choice              // Kombination (o)
+    )
+{
+  string part[3];
+  istringstream in(_str);
+  for (int p=0; p<3; p++)
+    if (!getline(in, part[p], '/'))
+      return false;
+
+  // Leerzeichen/Zeilenende am Schluss entfernen
+  part[2] = part[2].substr(0, part[2].find_last_not_of(" \r\t") + 1);
+
+  int f = -1, s = -1, p = -1;
+  for (int k=0; k<2; k++) if (part[0] == format_names[k])  f = k;
+  for (int k=0; k<4; k++) if (part[1] == solver_names[k])  s = k;
+  for (int k=0; k<6; k++) if (part[2] == precond_names[k]) p = k;
+
+  if (f < 0 || s < 0 || p < 0)
+    return false;
+
+  _choice.format  = (Matrix_Format) f;
+  _choice.solver  = (Solver_Kind)   s;
+  _choice.precond = (Precond_Kind)  p;
+
+  return true;
+}
@@ -125,7 +125,7 @@ void Matrix_Dense::print_mask()
 /** Anzahl der Zeilen/Spalten der Matrix abfragen
  *
  */
-int Matrix_Dense::get_size()
+int Matrix_Dense::get_size() const
 {
   return num_eq;
 }
@@ -155,7 +155,7 @@ void Matrix_Dense::add_entry(
 double Matrix_Dense::get_entry(
     int                           _n,                  // Zeilennummer
     int                           _m                   // Spaltennummer
-    )
+    ) const
 {
   return value[_n][_m];
 }
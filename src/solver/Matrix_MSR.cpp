@@ -33,6 +33,7 @@ mvs@ibb.uni-stuttgart.de
 
 #include "Matrix.h"
 #include "Discretization.h"
+#include <algorithm>
 
 
 
@@ -48,9 +49,9 @@ Matrix_MSR::Matrix_MSR(
   num_eq   = _dis->get_num_dof_solve();
 
 
-  Array1D< int >                     num_dc;
-  Array1D< List < int > >            dc;
-  _dis->fill_dof_connect(nnz, num_dc, dc, true);
+  Array1D<int>                       row_ptr;
+  Array1D<int>                       col;
+  _dis->fill_dof_connect(nnz, row_ptr, col, true);
 
 
   masked     = false;
@@ -69,13 +70,17 @@ Matrix_MSR::Matrix_MSR(
   index[num_eq] = nnz+1;
 
   /* write values to J */
+  int*       ip = index.get_dataptr();
+  int const* rp = row_ptr.get_dataptr();
+  int const* cp = col.get_dataptr();
+
   int counter = num_eq+1;
   for (int i=0; i<num_eq; i++)
   {
-    index[i] = counter;
-    for (int j=0;j<num_dc[i]; j++)
+    ip[i] = counter;
+    for (int j=rp[i]; j<rp[i+1]; j++)
     {
-      index[counter] = dc[i][j];
+      ip[counter] = cp[j];
       counter++;
     }
   }
@@ -95,6 +100,75 @@ Matrix_MSR::Matrix_MSR(
 
 
 
+/** Konstruktor fuer eine Matrix im MSR-Format aus einer Matrix im CSR-Format
+ * Die Spalten einer Zeile duerfen unsortiert sein und die Diagonale
+ * enthalten, doppelte Eintraege sind nicht erlaubt. Fehlt ein
+ * Diagonaleintrag, wird er zu Null gesetzt.
+ *
+ */
+Matrix_MSR::Matrix_MSR(
+    int                           _num_eq,            // Anzahl Zeilen/Spalten (i)
+    int const*                    _ptr,               // Zeilenanfaenge, Laenge num_eq+1 (i)
+    int const*                    _col,               // Spaltennummern (i)
+    double const*                 _val                // Werte (i)
+    )
+{
+  num_eq = _num_eq;
+
+  int num_offdiag = 0;
+  for (int i=0; i<num_eq; i++)
+    for (int p=_ptr[i]; p<_ptr[i+1]; p++)
+      if (_col[p] != i)
+        num_offdiag++;
+
+  nnz = num_eq + num_offdiag;
+
+  index.resize(nnz+1);
+  index.init();
+
+  value.resize(nnz+1);
+  value.init();
+
+  index[num_eq] = nnz+1;
+
+  Array1D<int> perm( max(num_eq,1) );
+  int counter = num_eq+1;
+
+  for (int i=0; i<num_eq; i++)
+  {
+    index[i] = counter;
+
+    // Nebendiagonal-Eintraege der Zeile nach Spalten sortieren
+    int m = 0;
+    for (int p=_ptr[i]; p<_ptr[i+1]; p++)
+    {
+      if (_col[p] == i)
+        value[i] = _val[p];
+      else
+        perm[m++] = p;
+    }
+
+    int* pp = perm.get_dataptr();
+    std::sort(pp, pp+m, [_col](int a, int b) { return _col[a] < _col[b]; });
+
+    for (int q=0; q<m; q++)
+    {
+      index[counter] = _col[ pp[q] ];
+      value[counter] = _val[ pp[q] ];
+      counter++;
+    }
+  }
+
+  masked     = true;
+  assembled  = true;
+  factorized = false;
+
+  return;
+}
+
+
+
+
 /** Setzt die Matrix auf leer zurueck
  * Loescht alle Vektoren und setzt alle Groessen auf Null.
  *
@@ -188,7 +262,7 @@ void Matrix_MSR::print_mask()
 /** Anzahl der Zeilen/Spalten der Matrix abfragen
  *
  */
-int Matrix_MSR::get_size()
+int Matrix_MSR::get_size() const
 {
   return num_eq;
 }
@@ -202,13 +276,113 @@ int Matrix_MSR::get_size()
 double Matrix_MSR::get_entry(
     int                           _n,                  // Zeilennummer
     int                           _m                   // Spaltennummer
-    )
+    ) const
 {
 
-  // TODO: get_entry fuer Matrix_MSR
+  int p = get_offset(_n, _m);
 
-  return 17;
+  return (p < 0) ? 0.0 : value[p];
 
 }
 
 
+
+
+/** Position eines Eintrags im Vektor der Werte
+ * Rueckgabe -1, wenn der Eintrag nicht in der Besetzungsstruktur liegt.
+ *
+ */
+int Matrix_MSR::get_offset(
+    int                           _n,                  // Zeilennummer (i)
+    int                           _m                   // Spaltennummer (i)
+    ) const
+{
+
+  if (_n == _m)
+    return _n;
+
+  // Spalten einer Zeile sind aufsteigend sortiert -> Bisektion
+  int lower = index[_n];
+  int upper = index[_n+1];
+
+  while (lower < upper)
+  {
+    int mitte = (lower+upper)/2;
+    if (index[mitte] == _m)
+      return mitte;
+    else if (index[mitte] < _m)
+      lower = mitte+1;
+    else
+      upper = mitte;
+  }
+
+  return -1;
+
+}
+
+
+
+
+
+
+/** Faerbung der Zeilen (Greedy) anhand des Besetzungsmusters
+ *  Das Muster entspricht der Kopplung der Freiheitsgrade aus
+ *  fill_dof_connect. Zeilen derselben Farbe sind nicht miteinander
+ *  gekoppelt und koennen z.B. im Gauss-Seidel-Verfahren gleichzeitig
+ *  bearbeitet werden.
+ *  Die Zeilen der Farbe c stehen in rows[color_ptr[c] .. color_ptr[c+1]-1],
+ *  Rueckgabe ist die Anzahl der Farben.
+ *
+ */
+int Matrix_MSR::color_rows(
+    Array1D<int>&                 _color_ptr,          // Beginn jeder Farbe in rows (o)
+    Array1D<int>&                 _rows                // Zeilen nach Farben sortiert (o)
+    ) const
+{
+  int const* idx = index.get_dataptr();
+
+  Array1D<int> color(num_eq);
+  Array1D<int> mark;                                   // mark[c] == i: Farbe c ist bei Zeile i belegt
+  int num_colors = 0;
+
+  for (int i=0; i<num_eq; i++)
+  {
+    // Farben der bereits gefaerbten Nachbarn markieren
+    for (int j=idx[i]; j<idx[i+1]; j++)
+    {
+      int k = idx[j];
+      if (k < i)
+        mark[ color[k] ] = i;
+    }
+
+    int c = 0;
+    while (c < num_colors && mark[c] == i)
+      c++;
+
+    if (c == num_colors)
+    {
+      num_colors++;
+      mark.resize(num_colors);
+      mark[c] = -1;
+    }
+
+    color[i] = c;
+  }
+
+  // Zeilen nach Farben sortieren (Zaehlsortierung, innerhalb einer Farbe aufsteigend)
+  _color_ptr.resize(num_colors+1);
+  _color_ptr.init();
+  for (int i=0; i<num_eq; i++)
+    _color_ptr[ color[i]+1 ]++;
+  for (int c=0; c<num_colors; c++)
+    _color_ptr[c+1] += _color_ptr[c];
+
+  _rows.resize(num_eq);
+  Array1D<int> pos(num_colors);
+  for (int c=0; c<num_colors; c++)
+    pos[c] = _color_ptr[c];
+  for (int i=0; i<num_eq; i++)
+    _rows[ pos[color[i]]++ ] = i;
+
+  return num_colors;
+}
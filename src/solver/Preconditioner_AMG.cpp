@@ -0,0 +1,504 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#include "Main.h"
+#include "Discretization.h"
+#include "Solver.h"
+
+
+/** Konstruktor: nur Parameter speichern, die Hierarchie entsteht in setup
+ *
+ */
+Preconditioner_AMG::Preconditioner_AMG(
+    Discretization*               _dis,                // Zeiger auf die Diskretisierung (i)
+    Smoother_Type                 _type,               // Typ der Glaetter (i)
+    int                           _coarse_size,        // Groesse des Grobgitters (i)
+    int                           _max_levels,         // maximale Anzahl Level (i)
+    double                        _theta               // Schranke fuer starke Kopplungen (i)
+    )
+  : Preconditioner_Multigrid(_type, _coarse_size, _max_levels)
+{
+  dis           = _dis;
+  theta         = _theta;
+}
+
+
+
+
+/** Vorbereitung: Aufbau der Mehrgitter-Hierarchie
+ *
+ */
+void Preconditioner_AMG::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  Matrix_MSR const* a = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (a == NULL)
+    throw runtime_error(string("AMG: only implemented for Matrix_MSR!!"));
+
+  cleanup();
+
+  int n = a->get_size();
+
+
+  // Knotennummer und Nahkern (Starrkoerperbewegungen) fuer jeden freien dof
+  const int nb = 3;
+  Array1D<int>    node(n);
+  Array2D<double> b(n, nb);
+  int             num_nodes = 0;
+
+  double xc  = 0.0;
+  double yc  = 0.0;
+  for (int i=0; i<dis->node_get_size(); i++)
+  {
+    xc += dis->node_get(i)->get_x();
+    yc += dis->node_get(i)->get_y();
+  }
+  xc /= dis->node_get_size();
+  yc /= dis->node_get_size();
+
+  for (int i=0; i<dis->node_get_size(); i++)
+  {
+    Node &act_node = *dis->node_get(i);
+
+    if ( act_node.get_bc_displ(0) && act_node.get_bc_displ(1) )
+      continue;
+
+    for (int j=0; j<2; j++)
+    {
+      if ( act_node.get_bc_displ(j) )
+        continue;
+
+      int d = act_node.dof_get(j);
+      node[d] = num_nodes;
+      b[d][0] = (j == 0) ? 1.0 : 0.0;
+      b[d][1] = (j == 1) ? 1.0 : 0.0;
+      b[d][2] = (j == 0) ? -(act_node.get_y()-yc) : (act_node.get_x()-xc);
+    }
+    num_nodes++;
+  }
+
+
+  // Level aufbauen, bis das Grobgitter klein genug ist
+  Matrix_MSR* a_own = NULL;
+
+  for (int l=0; ; l++)
+  {
+    Level* lev = add_level(a, a_own);
+
+    if (n <= coarse_size || l == max_levels-1)
+      break;
+
+
+    // Aggregation der Knoten
+    Array1D<int> agg(num_nodes);
+    int num_agg = aggregate(*a, node, num_nodes, theta, agg);
+
+    if (num_agg == 0 || num_agg >= num_nodes)
+      break;
+
+
+    // vorlaeufige Prolongation und Nahkern des Grobgitters
+    CSR             pt;
+    Array2D<double> b_c;
+    Array1D<int>    node_c;
+    int n_c = tentative(node, agg, num_agg, b, pt, b_c, node_c);
+
+    if (n_c >= n)
+      break;
+
+
+    // Glaettung der Prolongation: P = Pt - omega*D^-1*A*Pt
+    CSR a_csr;
+    msr_to_csr(*a, a_csr);
+
+    Array1D<double> diag_inv(n);
+    for (int i=0; i<n; i++)
+      diag_inv[i] = 1.0 / a->get_value()[i];
+
+    double omega = 4.0 / (3.0 * Smoother::estimate_lambda_max(*a, diag_inv));
+
+    CSR& p = lev->p;
+    multiply(a_csr, pt, p);
+
+    Array1D<double> work(n_c);
+    Array1D<int>    mark(n_c);
+    mark.init(-1);
+
+    for (int i=0; i<n; i++)
+    {
+      for (int k=pt.ptr[i]; k<pt.ptr[i+1]; k++)
+      {
+        mark[ pt.col[k] ] = i;
+        work[ pt.col[k] ] = pt.val[k];
+      }
+
+      double s = omega * diag_inv[i];
+      for (int k=p.ptr[i]; k<p.ptr[i+1]; k++)
+      {
+        int    j  = p.col[k];
+        double v0 = (mark[j] == i) ? work[j] : 0.0;
+        p.val[k]  = v0 - s*p.val[k];
+      }
+    }
+
+    transpose(p, lev->r);
+
+
+    // Galerkin-Produkt A_c = R*A*P
+    CSR ap;
+    CSR a_c;
+    multiply(a_csr, p, ap);
+    multiply(lev->r, ap, a_c);
+
+    a_own = new Matrix_MSR(n_c, a_c.ptr.get_dataptr(), a_c.col.get_dataptr(), a_c.val.get_dataptr());
+    a     = a_own;
+
+
+    // naechstes Level
+    n         = n_c;
+    num_nodes = num_agg;
+    node      = node_c;
+    b         = b_c;
+  }
+
+
+  finish_setup("AMG");
+
+  return;
+}
+
+
+
+
+/** Aggregation der Knoten ueber den Graphen der starken Kopplungen
+ *  Zwei Knoten I, J sind stark gekoppelt, wenn fuer die Frobenius-Normen der
+ *  Knotenbloecke gilt: |A_IJ|^2 > theta^2 * |A_II| * |A_JJ|
+ *  1. Knoten, deren starke Nachbarn alle frei sind, bilden mit diesen ein Aggregat
+ *  2. uebrige Knoten schliessen sich einem benachbarten Aggregat aus 1. an
+ *  3. verbleibende Knoten bilden mit ihren freien Nachbarn neue Aggregate
+ *  Rueckgabe ist die Anzahl der Aggregate.
+ *
+ */
+int Preconditioner_AMG::aggregate(
+    Matrix_MSR const&             _a,                  // Matrix des Levels (i)
+    Array1D<int> const&           _node,               // Knotennummer je dof (i)
+    int                           _num_nodes,          // Anzahl Knoten (i)
+    double                        _theta,              // Schranke fuer starke Kopplungen (i)
+    Array1D<int>&                 _agg                 // Aggregat je Knoten (o)
+    )
+{
+  int n = _a.get_size();
+
+  double const* val  = _a.get_value();
+  int    const* idx  = _a.get_index();
+  int    const* node = _node.get_dataptr();
+
+
+  // dofs je Knoten
+  Array1D<int> nd_ptr(_num_nodes+1);
+  Array1D<int> nd_dof(n);
+  nd_ptr.init();
+
+  for (int i=0; i<n; i++)
+    nd_ptr[ node[i]+1 ]++;
+  for (int k=0; k<_num_nodes; k++)
+    nd_ptr[k+1] += nd_ptr[k];
+
+  Array1D<int> pos(_num_nodes);
+  for (int k=0; k<_num_nodes; k++)
+    pos[k] = nd_ptr[k];
+  for (int i=0; i<n; i++)
+    nd_dof[ pos[node[i]]++ ] = i;
+
+
+  // Normen der Diagonalbloecke
+  Array1D<double> s_diag(_num_nodes);
+  s_diag.init();
+
+  for (int i=0; i<n; i++)
+  {
+    int I = node[i];
+    s_diag[I] += val[i]*val[i];
+    for (int k=idx[i]; k<idx[i+1]; k++)
+      if (node[ idx[k] ] == I)
+        s_diag[I] += val[k]*val[k];
+  }
+  for (int I=0; I<_num_nodes; I++)
+    s_diag[I] = sqrt(s_diag[I]);
+
+
+  // Graph der starken Kopplungen
+  Array1D<int>    sg_ptr(_num_nodes+1);
+  Array1D<int>    sg_adj(idx[n]-n);
+  Array1D<int>    nbr(_num_nodes);
+  Array1D<int>    mark(_num_nodes);
+  Array1D<double> s_off(_num_nodes);
+  mark.init(-1);
+
+  double theta2 = _theta*_theta;
+  int    cnt    = 0;
+
+  sg_ptr[0] = 0;
+  for (int I=0; I<_num_nodes; I++)
+  {
+    int num_nbr = 0;
+
+    for (int d=nd_ptr[I]; d<nd_ptr[I+1]; d++)
+    {
+      int i = nd_dof[d];
+      for (int k=idx[i]; k<idx[i+1]; k++)
+      {
+        int J = node[ idx[k] ];
+        if (J == I)
+          continue;
+        if (mark[J] != I)
+        {
+          mark[J]          = I;
+          s_off[J]         = 0.0;
+          nbr[num_nbr++]   = J;
+        }
+        s_off[J] += val[k]*val[k];
+      }
+    }
+
+    for (int k=0; k<num_nbr; k++)
+    {
+      int J = nbr[k];
+      if ( s_off[J] > theta2 * s_diag[I] * s_diag[J] )
+        sg_adj[cnt++] = J;
+    }
+    sg_ptr[I+1] = cnt;
+  }
+
+
+  // 1. Aggregate aus Knoten mit vollstaendig freier Nachbarschaft
+  int num_agg = 0;
+  _agg.init(-1);
+
+  for (int I=0; I<_num_nodes; I++)
+  {
+    if (_agg[I] >= 0 || sg_ptr[I+1] == sg_ptr[I])
+      continue;
+
+    bool all_free = true;
+    for (int k=sg_ptr[I]; k<sg_ptr[I+1]; k++)
+      if (_agg[ sg_adj[k] ] >= 0)
+      {
+        all_free = false;
+        break;
+      }
+
+    if (!all_free)
+      continue;
+
+    _agg[I] = num_agg;
+    for (int k=sg_ptr[I]; k<sg_ptr[I+1]; k++)
+      _agg[ sg_adj[k] ] = num_agg;
+    num_agg++;
+  }
+
+
+  // 2. Anschluss an ein benachbartes Aggregat aus Schritt 1
+  Array1D<int> agg1 = _agg;
+
+  for (int I=0; I<_num_nodes; I++)
+  {
+    if (agg1[I] >= 0)
+      continue;
+
+    for (int k=sg_ptr[I]; k<sg_ptr[I+1]; k++)
+      if (agg1[ sg_adj[k] ] >= 0)
+      {
+        _agg[I] = agg1[ sg_adj[k] ];
+        break;
+      }
+  }
+
+
+  // 3. verbleibende Knoten
+  for (int I=0; I<_num_nodes; I++)
+  {
+    if (_agg[I] >= 0)
+      continue;
+
+    _agg[I] = num_agg;
+    for (int k=sg_ptr[I]; k<sg_ptr[I+1]; k++)
+      if (_agg[ sg_adj[k] ] < 0)
+        _agg[ sg_adj[k] ] = num_agg;
+    num_agg++;
+  }
+
+  return num_agg;
+}
+
+
+
+
+/** Vorlaeufige Prolongation aus dem Nahkern
+ *  Fuer jedes Aggregat wird der zugehoerige Block des Nahkerns B mit einer
+ *  modifizierten Gram-Schmidt-Orthogonalisierung zerlegt, B = Q*R. Q liefert
+ *  die Zeilen von Pt, R den Nahkern des Grobgitters. Linear abhaengige Spalten
+ *  (z.B. Aggregate aus einem Knoten) werden verworfen.
+ *  Rueckgabe ist die Anzahl der dofs des Grobgitters.
+ *
+ */
+int Preconditioner_AMG::tentative(
+    Array1D<int> const&           _node,               // Knotennummer je dof (i)
+    Array1D<int> const&           _agg,                // Aggregat je Knoten (i)
+    int                           _num_agg,            // Anzahl Aggregate (i)
+    Array2D<double> const&        _b,                  // Nahkern (i)
+    CSR&                          _pt,                 // vorlaeufige Prolongation (o)
+    Array2D<double>&              _b_c,                // Nahkern des Grobgitters (o)
+    Array1D<int>&                 _node_c              // Knotennummer (= Aggregat) je Grob-dof (o)
+    )
+{
+  int n  = _node.get_size();
+  int nb = _b.get_size_2();
+
+
+  // dofs je Aggregat
+  Array1D<int> ag_ptr(_num_agg+1);
+  Array1D<int> ag_dof(n);
+  ag_ptr.init();
+
+  for (int i=0; i<n; i++)
+    ag_ptr[ _agg[_node[i]]+1 ]++;
+  for (int g=0; g<_num_agg; g++)
+    ag_ptr[g+1] += ag_ptr[g];
+
+  Array1D<int> pos(_num_agg);
+  for (int g=0; g<_num_agg; g++)
+    pos[g] = ag_ptr[g];
+  for (int i=0; i<n; i++)
+    ag_dof[ pos[_agg[_node[i]]]++ ] = i;
+
+  int n_max = 0;
+  for (int g=0; g<_num_agg; g++)
+    n_max += min(ag_ptr[g+1]-ag_ptr[g], nb);
+
+
+  // Pt zunaechst mit nb Plaetzen pro Zeile
+  Array1D<int>    cnt(n);
+  Array1D<int>    col(n*nb);
+  Array1D<double> val(n*nb);
+  _b_c.resize(n_max, nb);
+  _node_c.resize(n_max);
+
+  int n_c = 0;
+
+  for (int g=0; g<_num_agg; g++)
+  {
+    int m  = ag_ptr[g+1]-ag_ptr[g];
+    int c0 = n_c;
+    int rank = 0;
+
+    Array2D<double> q(m, nb);
+    Array1D<double> v(m);
+
+    for (int k=0; k<nb; k++)
+    {
+      for (int li=0; li<m; li++)
+        v[li] = _b[ ag_dof[ag_ptr[g]+li] ][k];
+
+      double norm0 = 0.0;
+      for (int li=0; li<m; li++)
+        norm0 += v[li]*v[li];
+      norm0 = sqrt(norm0);
+
+      for (int c=0; c<rank; c++)
+      {
+        double r = 0.0;
+        for (int li=0; li<m; li++)
+          r += q[li][c]*v[li];
+        for (int li=0; li<m; li++)
+          v[li] -= r*q[li][c];
+        _b_c[c0+c][k] = r;
+      }
+
+      double norm = 0.0;
+      for (int li=0; li<m; li++)
+        norm += v[li]*v[li];
+      norm = sqrt(norm);
+
+      if (norm > 1e-10*norm0 && norm > 0.0)
+      {
+        for (int li=0; li<m; li++)
+          q[li][rank] = v[li]/norm;
+        for (int c=0; c<k; c++)
+          _b_c[c0+rank][c] = 0.0;
+        _b_c[c0+rank][k] = norm;
+        rank++;
+      }
+    }
+
+    for (int li=0; li<m; li++)
+    {
+      int i = ag_dof[ag_ptr[g]+li];
+      cnt[i] = rank;
+      for (int c=0; c<rank; c++)
+      {
+        col[i*nb+c] = c0+c;
+        val[i*nb+c] = q[li][c];
+      }
+    }
+
+    for (int c=0; c<rank; c++)
+      _node_c[c0+c] = g;
+    n_c += rank;
+  }
+
+  _b_c.resize(n_c, nb);
+  _node_c.resize(n_c);
+
+
+  // kompaktes CSR-Format
+  _pt.num_rows = n;
+  _pt.num_cols = n_c;
+  _pt.ptr.resize(n+1);
+  _pt.ptr[0] = 0;
+  for (int i=0; i<n; i++)
+    _pt.ptr[i+1] = _pt.ptr[i] + cnt[i];
+
+  _pt.col.resize(_pt.ptr[n]);
+  _pt.val.resize(_pt.ptr[n]);
+  for (int i=0; i<n; i++)
+    for (int c=0; c<cnt[i]; c++)
+    {
+      _pt.col[_pt.ptr[i]+c] = col[i*nb+c];
+      _pt.val[_pt.ptr[i]+c] = val[i*nb+c];
+    }
+
+  return n_c;
+}
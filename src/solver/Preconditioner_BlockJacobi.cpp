@@ -0,0 +1,139 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Discretization.h"
+#include "Solver.h"
+
+
+/** Konstruktor: Knoten-Bloecke aus der Diskretisierung aufstellen
+ *
+ */
+Preconditioner_BlockJacobi::Preconditioner_BlockJacobi(
+    Discretization*               _dis                 // Zeiger auf die Diskretisierung (i)
+    )
+{
+  num_blocks = 0;
+  block_dof.resize( 2*_dis->node_get_size() );
+
+  for (int i=0; i<_dis->node_get_size(); i++)
+  {
+    Node &act_node = *_dis->node_get(i);
+
+    // Knoten ohne freie Freiheitsgrade liefern keinen Block
+    if ( act_node.get_bc_displ(0) && act_node.get_bc_displ(1) )
+      continue;
+
+    for (int j=0; j<2; j++)
+      block_dof[2*num_blocks+j] = act_node.get_bc_displ(j) ? -1 : act_node.dof_get(j);
+
+    num_blocks++;
+  }
+
+  block_inv.resize(4*num_blocks);
+}
+
+
+
+
+/** Vorbereitung: Knoten-Bloecke der Matrix invertieren
+ *
+ */
+void Preconditioner_BlockJacobi::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  for (int b=0; b<num_blocks; b++)
+  {
+    int     d0  = block_dof[2*b];
+    int     d1  = block_dof[2*b+1];
+    double* inv = block_inv.get_dataptr() + 4*b;
+
+    inv[0] = inv[1] = inv[2] = inv[3] = 0.0;
+
+    if (d0 >= 0 && d1 >= 0)
+    {
+      double a00 = _a.get_entry(d0,d0);
+      double a01 = _a.get_entry(d0,d1);
+      double a10 = _a.get_entry(d1,d0);
+      double a11 = _a.get_entry(d1,d1);
+      double det = a00*a11 - a01*a10;
+
+      inv[0] =  a11/det;
+      inv[1] = -a01/det;
+      inv[2] = -a10/det;
+      inv[3] =  a00/det;
+    }
+    else if (d0 >= 0)
+      inv[0] = 1.0 / _a.get_entry(d0,d0);
+    else
+      inv[3] = 1.0 / _a.get_entry(d1,d1);
+  }
+
+  return;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers: out = blockdiag(A)^-1 * in
+ *
+ */
+void Preconditioner_BlockJacobi::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int    const* bd  = block_dof.get_dataptr();
+  double const* bi  = block_inv.get_dataptr();
+  double const* in  = _in.get_dataptr();
+  double*       out = _out.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int b=0; b<num_blocks; b++)
+  {
+    int           d0  = bd[2*b];
+    int           d1  = bd[2*b+1];
+    double const* inv = bi + 4*b;
+
+    double x0 = (d0 >= 0) ? in[d0] : 0.0;
+    double x1 = (d1 >= 0) ? in[d1] : 0.0;
+
+    if (d0 >= 0)
+      out[d0] = inv[0]*x0 + inv[1]*x1;
+    if (d1 >= 0)
+      out[d1] = inv[2]*x0 + inv[3]*x1;
+  }
+
+  return;
+}
@@ -0,0 +1,127 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: innerer Vorkonditionierer und Eigenwertintervall
+ *  lambda_max wird aufgeweitet, damit das Polynom auf dem ganzen Spektrum
+ *  betragsmaessig kleiner 1 bleibt und der Vorkonditionierer positiv ist.
+ *
+ */
+void Preconditioner_Chebyshev::setup(
+    Matrix const&                 _a                   // Matrix (i)
+    )
+{
+  int n = _a.get_size();
+
+  a = &_a;
+  inner->setup(_a);
+
+  r.resize(n);
+  h.resize(n);
+  d.resize(n);
+
+  Solver_CG::estimate_bounds(_a, *inner, lanczos_ite, lambda_min, lambda_max);
+  lambda_max *= 1.1;
+  lambda_min *= 0.9;
+
+  return;
+}
+
+
+
+
+/** out = p(C*A)*C*in, degree Chebyshev-Schritte fuer a*out=in ab Null
+ *
+ */
+void Preconditioner_Chebyshev::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor (i)
+    Array1D<double>&              _out                 // Ergebnis (o)
+    ) const
+{
+  int n = a->get_size();
+
+  double const* in  = _in.get_dataptr();
+  double*       out = _out.get_dataptr();
+  double*       rp  = r.get_dataptr();
+  double*       hp  = h.get_dataptr();
+  double*       dp  = d.get_dataptr();
+
+  double theta = 0.5 * (lambda_max + lambda_min);
+  double delta = 0.5 * (lambda_max - lambda_min);
+  double sigma = theta / delta;
+  double rho   = 1.0 / sigma;
+
+  inner->apply(_in, h);
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    rp[i]  = in[i];
+    dp[i]  = hp[i] / theta;
+    out[i] = 0.0;
+  }
+
+  for (int k=0; k<degree; k++)
+  {
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      out[i] += dp[i];
+
+    if (k == degree-1)
+      break;
+
+    // r = r - A*d, h dient als Zwischenspeicher fuer A*d
+    a->mult(d, h);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      rp[i] -= hp[i];
+
+    inner->apply(r, h);
+
+    double rho_new = 1.0 / (2.0*sigma - rho);
+    double c1      = rho_new * rho;
+    double c2      = 2.0 * rho_new / delta;
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      dp[i] = c1 * dp[i] + c2 * hp[i];
+
+    rho = rho_new;
+  }
+
+  return;
+}
@@ -0,0 +1,276 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Discretization.h"
+#include "Solver.h"
+
+
+/** Konstruktor: nur Parameter speichern, die Hierarchie entsteht in setup
+ *
+ */
+Preconditioner_GMG::Preconditioner_GMG(
+    Discretization*               _dis,                // Zeiger auf die Diskretisierung (i)
+    Smoother_Type                 _type,               // Typ der Glaetter (i)
+    int                           _coarse_size,        // Groesse des Grobgitters (i)
+    int                           _max_levels          // maximale Anzahl Level (i)
+    )
+  : Preconditioner_Multigrid(_type, _coarse_size, _max_levels)
+{
+  dis       = _dis;
+  num_dis_c = 0;
+}
+
+
+
+
+/** Destruktor
+ *
+ */
+Preconditioner_GMG::~Preconditioner_GMG()
+{
+  cleanup();
+}
+
+
+
+
+/** Loescht die Hierarchie und die groben Diskretisierungen
+ *
+ */
+void Preconditioner_GMG::cleanup()
+{
+  Preconditioner_Multigrid::cleanup();
+
+  for (int i=0; i<num_dis_c; i++)
+    delete dis_c[i];
+  num_dis_c = 0;
+
+  return;
+}
+
+
+
+
+/** Vorhersage ohne Aufbau der Hierarchie, ob setup bis coarse_size vergroebern kann
+ *  Die Anzahl der Freiheitsgrade je Level wird mit 2 pro Knoten nach oben
+ *  abgeschaetzt (ohne Dirichlet-RB).
+ *
+ */
+bool Preconditioner_GMG::coarsens() const
+{
+  int div_x = dis->get_div_x();
+  int div_y = dis->get_div_y();
+
+  if ( dis->node_get_size() != (div_x+1)*(div_y+1) )
+    return false;
+
+  for (int l=1; l<max_levels; l++)
+  {
+    if ( 2*(div_x+1)*(div_y+1) <= coarse_size )
+      return true;
+
+    if ( div_x == 1 && div_y == 1 )
+      break;
+
+    div_x = (div_x+1)/2;
+    div_y = (div_y+1)/2;
+  }
+
+  return 2*(div_x+1)*(div_y+1) <= coarse_size;
+}
+
+
+
+
+/** Vorbereitung: Aufbau der Hierarchie aus vergroeberten Diskretisierungen
+ *
+ */
+void Preconditioner_GMG::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  Matrix_MSR const* a = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (a == NULL)
+    throw runtime_error(string("GMG: only implemented for Matrix_MSR!!"));
+
+  if ( dis->node_get_size() != (dis->get_div_x()+1)*(dis->get_div_y()+1) )
+    throw runtime_error(string("GMG: discretization is not a structured mesh!!"));
+
+  cleanup();
+
+  Discretization* fine = dis;
+  Level*          lev  = add_level(a, NULL);
+
+  while ( lev->a->get_size() > coarse_size && num_levels < max_levels )
+  {
+    int div_x   = fine->get_div_x();
+    int div_y   = fine->get_div_y();
+    int div_x_c = (div_x+1)/2;
+    int div_y_c = (div_y+1)/2;
+
+    if ( div_x_c == div_x && div_y_c == div_y )
+      break;
+
+
+    // grobe Diskretisierung
+    Discretization* coarse_dis = new Discretization(fine->get_l_x(), fine->get_l_y(), div_x_c, div_y_c, false,
+        fine->get_renumber());
+
+    if (dis_c.get_size() <= num_dis_c)
+      dis_c.resize(num_dis_c+1);
+    dis_c[num_dis_c] = coarse_dis;
+    num_dis_c++;
+
+
+    // Transfer zwischen den Leveln
+    prolongation(fine, coarse_dis, lev->p);
+    transpose(lev->p, lev->r);
+
+
+    // Grobgittermatrix: bei geschachtelten Netzen neu assembliert, sonst
+    // als Galerkin-Produkt R*A*P
+    Matrix_MSR* a_c;
+    if ( div_x%2 == 0 && div_y%2 == 0 )
+    {
+      a_c = new Matrix_MSR(coarse_dis);
+      coarse_dis->assemble_stalin(a_c);
+    }
+    else
+    {
+      CSR a_csr;
+      CSR ap;
+      CSR rap;
+      msr_to_csr(*lev->a, a_csr);
+      multiply(a_csr, lev->p, ap);
+      multiply(lev->r, ap, rap);
+      a_c = new Matrix_MSR(rap.num_rows, rap.ptr.get_dataptr(), rap.col.get_dataptr(), rap.val.get_dataptr());
+    }
+
+    fine = coarse_dis;
+    lev  = add_level(a_c, a_c);
+  }
+
+  finish_setup("GMG");
+
+  return;
+}
+
+
+
+
+/** Bilineare Interpolation vom groben auf das feine Q1-Netz
+ *  Knoten j des feinen Netzes liegt bei j*nx_c/nx_f im groben Netz (in y
+ *  entsprechend), interpoliert wird zwischen den beiden umgebenden groben
+ *  Knoten. Bei halbierter Unterteilung ist das (j/2,i/2) bzw. der
+ *  Mittelwert der Nachbarn, sonst sind die Netze nicht geschachtelt.
+ *  Durch Dirichlet-RB gehaltene Freiheitsgrade des groben Netzes liefern
+ *  keinen Beitrag.
+ *
+ */
+void Preconditioner_GMG::prolongation(
+    Discretization*               _fine,               // feine Diskretisierung (i)
+    Discretization*               _coarse,             // grobe Diskretisierung (i)
+    CSR&                          _p                   // Prolongation (o)
+    )
+{
+  int nx_f = _fine->get_div_x();
+  int ny_f = _fine->get_div_y();
+  int nx_c = _coarse->get_div_x();
+  int ny_c = _coarse->get_div_y();
+  int n_f  = _fine->get_num_dof_solve();
+  int n_c  = _coarse->get_num_dof_solve();
+
+
+  // zunaechst mit 4 Plaetzen pro Zeile
+  Array1D<int>    cnt(n_f);
+  Array1D<int>    col(4*n_f);
+  Array1D<double> val(4*n_f);
+  cnt.init();
+
+  for (int i=0; i<ny_f+1; i++)
+    for (int j=0; j<nx_f+1; j++)
+    {
+      Node& act_node = *_fine->node_get( j + (nx_f+1)*i );
+
+      // umgebende grobe Knoten und ihre Gewichte je Richtung
+      int    jc[2] = { (j*nx_c)/nx_f, (j*nx_c)/nx_f + 1 };
+      int    ic[2] = { (i*ny_c)/ny_f, (i*ny_c)/ny_f + 1 };
+      double tx    = (double)((j*nx_c)%nx_f) / nx_f;
+      double ty    = (double)((i*ny_c)%ny_f) / ny_f;
+      double wx[2] = { 1.0-tx, tx };
+      double wy[2] = { 1.0-ty, ty };
+      int    njc   = (tx > 0.0) ? 2 : 1;
+      int    nic   = (ty > 0.0) ? 2 : 1;
+
+      for (int k=0; k<2; k++)
+      {
+        if ( act_node.get_bc_displ(k) )
+          continue;
+
+        int d = act_node.dof_get(k);
+
+        for (int ii=0; ii<nic; ii++)
+          for (int jj=0; jj<njc; jj++)
+          {
+            Node& c_node = *_coarse->node_get( jc[jj] + (nx_c+1)*ic[ii] );
+            if ( c_node.get_bc_displ(k) )
+              continue;
+
+            col[4*d+cnt[d]] = c_node.dof_get(k);
+            val[4*d+cnt[d]] = wy[ii]*wx[jj];
+            cnt[d]++;
+          }
+      }
+    }
+
+
+  // kompaktes CSR-Format
+  _p.num_rows = n_f;
+  _p.num_cols = n_c;
+  _p.ptr.resize(n_f+1);
+  _p.ptr[0] = 0;
+  for (int d=0; d<n_f; d++)
+    _p.ptr[d+1] = _p.ptr[d] + cnt[d];
+
+  _p.col.resize(_p.ptr[n_f]);
+  _p.val.resize(_p.ptr[n_f]);
+  for (int d=0; d<n_f; d++)
+    for (int c=0; c<cnt[d]; c++)
+    {
+      _p.col[_p.ptr[d]+c] = col[4*d+c];
+      _p.val[_p.ptr[d]+c] = val[4*d+c];
+    }
+
+  return;
+}
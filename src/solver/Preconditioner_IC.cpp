@@ -0,0 +1,285 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+#include <algorithm>
+
+
+/** Vorbereitung des Vorkonditionierers
+ *  Wiederholt die Zerlegung mit wachsender Verschiebung der Diagonalen,
+ *  bis alle Diagonalelemente positiv sind.
+ *
+ */
+void Preconditioner_IC::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+
+  Matrix_MSR const* msr = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (msr == NULL)
+    throw runtime_error(string("IC: only implemented for Matrix_MSR!!"));
+
+  double alpha = 0.0;
+
+  for (int attempt=0; attempt<20; attempt++)
+  {
+    if ( factor(*msr, alpha) )
+    {
+      shift = alpha;
+      if (shift != 0.0)
+        cout << "IC: diagonal shifted by alpha = " << shift << endl;
+      return;
+    }
+
+    alpha = (alpha == 0.0) ? 1e-3 : 2.0*alpha;
+  }
+
+  throw runtime_error(string("IC: factorization failed!!"));
+}
+
+
+
+
+/** Berechnung der unvollstaendigen Zerlegung (zeilenweise IKJ-Variante)
+ *  Fuer jede Zeile i wird die Zeile von A in einen Arbeitsvektor w geladen
+ *  und mit den bereits berechneten Zeilen k < i von Ut eliminiert.
+ *  Der obere Teil von w ergibt danach die Zeile i von U = D*Ut.
+ *  Rueckgabe false, wenn ein Diagonalelement nicht positiv ist.
+ *
+ */
+bool Preconditioner_IC::factor(
+    Matrix_MSR const&             _a,                  // Matrix des LGS (i)
+    double                        _shift               // Verschiebung der Diagonalen (i)
+    )
+{
+
+  num_eq = _a.get_size();
+  int n  = num_eq;
+
+  double const* av = _a.get_value();
+  int    const* ai = _a.get_index();
+
+
+  // Anzahl der Eintraege im oberen Dreieck von A -> maximale Groesse von Ut
+  int cap = 0;
+  for (int i=0; i<n; i++)
+  {
+    int upper_a = 0;
+    for (int p=ai[i]; p<ai[i+1]; p++)
+      if (ai[p] > i)
+        upper_a++;
+    cap += threshold ? upper_a + fill : upper_a;
+  }
+
+  row_ptr.resize(n+1);
+  col.resize(max(cap,1));
+  val.resize(max(cap,1));
+  diag_inv.resize(n);
+
+  int*    rp = row_ptr.get_dataptr();
+  int*    uc = col.get_dataptr();
+  double* uv = val.get_dataptr();
+  double* di = diag_inv.get_dataptr();
+
+
+  // Arbeitsvektoren
+  Array1D<double> w(n);
+  Array1D<int>    marker(n);
+  Array1D<int>    lower(n);
+  Array1D<int>    upper(n);
+  marker.init(-1);
+
+  double* wp = w.get_dataptr();
+  int*    mk = marker.get_dataptr();
+  int*    lo = lower.get_dataptr();
+  int*    up = upper.get_dataptr();
+
+  int pos = 0;
+
+  for (int i=0; i<n; i++)
+  {
+    rp[i] = pos;
+
+    // Zeile i von A laden
+    int nl = 0;
+    int nu = 0;
+    double norm = av[i]*av[i];
+
+    mk[i] = i;
+    wp[i] = av[i] * (1.0 + _shift);
+
+    for (int p=ai[i]; p<ai[i+1]; p++)
+    {
+      int j  = ai[p];
+      mk[j]  = i;
+      wp[j]  = av[p];
+      norm  += av[p]*av[p];
+
+      if (j < i)
+        lo[nl++] = j;
+      else
+        up[nu++] = j;
+    }
+
+    int    upper_a = nu;
+    double tau     = drop_tol * sqrt(norm);
+
+
+    // Elimination mit den Zeilen k < i in aufsteigender Reihenfolge
+    for (int q=0; q<nl; q++)
+    {
+      int m = q;
+      for (int r=q+1; r<nl; r++)
+        if (lo[r] < lo[m])
+          m = r;
+      std::swap(lo[q], lo[m]);
+
+      int    k    = lo[q];
+      double mult = wp[k];
+
+      if ( mult == 0.0 || (threshold && fabs(mult) <= tau) )
+        continue;
+
+      for (int pp=rp[k]; pp<rp[k+1]; pp++)
+      {
+        int j = uc[pp];
+
+        if (mk[j] == i)
+        {
+          wp[j] -= mult * uv[pp];
+        }
+        else if (threshold)
+        {
+          // Auffuellung (nur ICT)
+          mk[j] = i;
+          wp[j] = -mult * uv[pp];
+
+          if (j < i)
+            lo[nl++] = j;
+          else
+            up[nu++] = j;
+        }
+      }
+    }
+
+
+    // Diagonale pruefen
+    double d = wp[i];
+    if ( !(d > 0.0) )
+      return false;
+
+    di[i] = 1.0/d;
+
+
+    // oberen Teil der Zeile ablegen, fuer ICT kleine Eintraege verwerfen
+    int keep = nu;
+    if (threshold)
+    {
+      keep = 0;
+      for (int q=0; q<nu; q++)
+        if (fabs(wp[up[q]]) > tau)
+          up[keep++] = up[q];
+
+      int max_keep = upper_a + fill;
+      if (keep > max_keep)
+      {
+        std::nth_element(up, up+max_keep, up+keep,
+            [wp](int a, int b) { return fabs(wp[a]) > fabs(wp[b]); });
+        keep = max_keep;
+      }
+    }
+
+    std::sort(up, up+keep);
+
+    for (int q=0; q<keep; q++)
+    {
+      uc[pos] = up[q];
+      uv[pos] = wp[up[q]] / d;
+      pos++;
+    }
+  }
+
+  rp[n] = pos;
+
+  return true;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers: out = (Ut^T * D * Ut)^-1 * in
+ *  1. Ut^T * y = in  (vorwaerts, spaltenweise ueber die Zeilen von Ut)
+ *  2. y = D^-1 * y
+ *  3. Ut * out = y   (rueckwaerts, zeilenweise)
+ *
+ */
+void Preconditioner_IC::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int n = num_eq;
+
+  int    const* rp = row_ptr.get_dataptr();
+  int    const* uc = col.get_dataptr();
+  double const* uv = val.get_dataptr();
+  double const* di = diag_inv.get_dataptr();
+  double const* in = _in.get_dataptr();
+  double*       y  = _out.get_dataptr();
+
+  for (int i=0; i<n; i++)
+    y[i] = in[i];
+
+
+  // forward
+  for (int i=0; i<n; i++)
+  {
+    double y_i = y[i];
+    for (int pp=rp[i]; pp<rp[i+1]; pp++)
+      y[uc[pp]] -= uv[pp] * y_i;
+    y[i] = y_i * di[i];
+  }
+
+
+  // backward
+  for (int i=n-1; i>=0; i--)
+  {
+    double sum = y[i];
+    for (int pp=rp[i]; pp<rp[i+1]; pp++)
+      sum -= uv[pp] * y[uc[pp]];
+    y[i] = sum;
+  }
+
+  return;
+}
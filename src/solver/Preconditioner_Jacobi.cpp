@@ -0,0 +1,76 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Inverse der Diagonalen speichern
+ *
+ */
+void Preconditioner_Jacobi::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  int n = _a.get_size();
+  diag_inv.resize(n);
+
+  for (int i=0; i<n; i++)
+    diag_inv[i] = 1.0 / _a.get_entry(i,i);
+
+  return;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers: out = D^-1 * in
+ *
+ */
+void Preconditioner_Jacobi::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int n = diag_inv.get_size();
+
+  double const* di  = diag_inv.get_dataptr();
+  double const* in  = _in.get_dataptr();
+  double*       out = _out.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+    out[i] = di[i] * in[i];
+
+  return;
+}
@@ -0,0 +1,425 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Konstruktor: nur Parameter speichern, die Hierarchie entsteht in setup
+ *
+ */
+Preconditioner_Multigrid::Preconditioner_Multigrid(
+    Smoother_Type                 _type,               // Typ der Glaetter (i)
+    int                           _coarse_size,        // Groesse des Grobgitters (i)
+    int                           _max_levels          // maximale Anzahl Level (i)
+    )
+{
+  smoother_type = _type;
+  coarse_size   = _coarse_size;
+  max_levels    = _max_levels;
+
+  num_levels    = 0;
+  coarse        = NULL;
+}
+
+
+
+
+/** Destruktor
+ *
+ */
+Preconditioner_Multigrid::~Preconditioner_Multigrid()
+{
+  cleanup();
+}
+
+
+
+
+/** Loescht die Hierarchie
+ *
+ */
+void Preconditioner_Multigrid::cleanup()
+{
+  for (int l=0; l<num_levels; l++)
+  {
+    delete levels[l]->smoother;
+    delete levels[l]->a_own;
+    delete levels[l];
+  }
+  num_levels = 0;
+
+  delete coarse;
+  coarse = NULL;
+
+  return;
+}
+
+
+
+
+/** Neues (groeberes) Level an die Hierarchie anhaengen
+ *
+ */
+Preconditioner_Multigrid::Level* Preconditioner_Multigrid::add_level(
+    Matrix_MSR const*             _a,                  // Matrix des Levels (i)
+    Matrix_MSR*                   _a_own               // zu loeschende Matrix oder NULL (i)
+    )
+{
+  int n = _a->get_size();
+
+  if (levels.get_size() <= num_levels)
+    levels.resize(num_levels+1);
+
+  Level* lev    = new Level;
+  lev->a        = _a;
+  lev->a_own    = _a_own;
+  lev->smoother = NULL;
+  lev->x.resize(n);
+  lev->b.resize(n);
+  lev->res.resize(n);
+  lev->p.num_rows = lev->p.num_cols = 0;
+  lev->r.num_rows = lev->r.num_cols = 0;
+
+  levels[num_levels] = lev;
+  num_levels++;
+
+  return lev;
+}
+
+
+
+
+/** Abschluss von setup: Glaetter, Grobgitterloeser und Ausgabe der Hierarchie
+ *
+ */
+void Preconditioner_Multigrid::finish_setup(
+    char const*                   _name                // Bezeichnung fuer die Ausgabe (i)
+    )
+{
+  // Glaetter fuer alle Level ausser dem groebsten
+  for (int l=0; l<num_levels-1; l++)
+  {
+    levels[l]->smoother = Smoother::create(smoother_type);
+    levels[l]->smoother->setup(*levels[l]->a);
+  }
+
+
+  // direkter Loeser auf dem groebsten Level, die Matrix wird dabei nur gelesen
+  if (levels[num_levels-1]->a->get_size() > coarse_size)
+    throw runtime_error(string(_name) + ": coarsest level larger than coarse_size!!");
+
+  coarse = new Solver_Cholesky();
+  coarse->factorize( const_cast<Matrix_MSR&>(*levels[num_levels-1]->a) );
+
+
+  cout << _name << ": " << num_levels << " levels" << endl;
+  for (int l=0; l<num_levels; l++)
+    printf("  level %2d: %8d dofs %10d nnz\n", l, levels[l]->a->get_size(), levels[l]->a->get_nnz());
+
+  return;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers: ein V-Zyklus fuer A*out = in
+ *
+ */
+void Preconditioner_Multigrid::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int n = _in.get_size();
+
+  double const* in  = _in.get_dataptr();
+  double*       out = _out.get_dataptr();
+  double*       b0  = levels[0]->b.get_dataptr();
+  double const* x0  = levels[0]->x.get_dataptr();
+
+  for (int i=0; i<n; i++)
+    b0[i] = in[i];
+
+  vcycle(0);
+
+  for (int i=0; i<n; i++)
+    out[i] = x0[i];
+
+  return;
+}
+
+
+
+
+/** V-Zyklus auf Level l mit Startwert Null
+ *  rechte Seite in levels[l]->b, Ergebnis in levels[l]->x
+ *
+ */
+void Preconditioner_Multigrid::vcycle(
+    int                           _l                   // Level (i)
+    ) const
+{
+  Level& lev = *levels[_l];
+
+  if (_l == num_levels-1)
+  {
+    coarse->solve(lev.x, lev.b);
+    return;
+  }
+
+  Level& next = *levels[_l+1];
+  int    n    = lev.a->get_size();
+
+  double const* b = lev.b.get_dataptr();
+  double*       r = lev.res.get_dataptr();
+
+  // Vorglaettung
+  lev.x.init();
+  lev.smoother->smooth(lev.b, lev.x);
+
+  // Residuum restringieren
+  lev.a->mult(lev.x, lev.res);
+  for (int i=0; i<n; i++)
+    r[i] = b[i] - r[i];
+
+  mult(lev.r, lev.res, next.b, false);
+
+  // Grobgitterkorrektur
+  vcycle(_l+1);
+  mult(lev.p, next.x, lev.x, true);
+
+  // Nachglaettung
+  lev.smoother->smooth(lev.b, lev.x);
+
+  return;
+}
+
+
+
+
+/** Umwandlung einer MSR-Matrix in das CSR-Format (Diagonale zuerst)
+ *
+ */
+void Preconditioner_Multigrid::msr_to_csr(
+    Matrix_MSR const&             _a,                  // Matrix im MSR-Format (i)
+    CSR&                          _c                   // Matrix im CSR-Format (o)
+    )
+{
+  int n = _a.get_size();
+
+  double const* val = _a.get_value();
+  int    const* idx = _a.get_index();
+
+  _c.num_rows = n;
+  _c.num_cols = n;
+  _c.ptr.resize(n+1);
+  _c.col.resize(idx[n]-1);
+  _c.val.resize(idx[n]-1);
+
+  int pos = 0;
+  for (int i=0; i<n; i++)
+  {
+    _c.ptr[i] = pos;
+    _c.col[pos] = i;
+    _c.val[pos] = val[i];
+    pos++;
+    for (int k=idx[i]; k<idx[i+1]; k++)
+    {
+      _c.col[pos] = idx[k];
+      _c.val[pos] = val[k];
+      pos++;
+    }
+  }
+  _c.ptr[n] = pos;
+
+  return;
+}
+
+
+
+
+/** Matrix-Matrix-Produkt C = A*B (Gustavson, zeilenweise)
+ *  Im ersten Durchlauf wird die Besetzungsstruktur gezaehlt, im zweiten
+ *  werden die Werte berechnet.
+ *
+ */
+void Preconditioner_Multigrid::multiply(
+    CSR const&                    _a,                  // linker Faktor (i)
+    CSR const&                    _b,                  // rechter Faktor (i)
+    CSR&                          _c                   // Produkt (o)
+    )
+{
+  int n = _a.num_rows;
+  int m = _b.num_cols;
+
+  int    const* a_ptr = _a.ptr.get_dataptr();
+  int    const* a_col = _a.col.get_dataptr();
+  double const* a_val = _a.val.get_dataptr();
+  int    const* b_ptr = _b.ptr.get_dataptr();
+  int    const* b_col = _b.col.get_dataptr();
+  double const* b_val = _b.val.get_dataptr();
+
+  Array1D<int> mark(m);
+  mark.init(-1);
+
+  _c.num_rows = n;
+  _c.num_cols = m;
+  _c.ptr.resize(n+1);
+  _c.ptr[0] = 0;
+
+  for (int i=0; i<n; i++)
+  {
+    int cnt = 0;
+    for (int ka=a_ptr[i]; ka<a_ptr[i+1]; ka++)
+    {
+      int k = a_col[ka];
+      for (int kb=b_ptr[k]; kb<b_ptr[k+1]; kb++)
+        if (mark[ b_col[kb] ] != i)
+        {
+          mark[ b_col[kb] ] = i;
+          cnt++;
+        }
+    }
+    _c.ptr[i+1] = _c.ptr[i] + cnt;
+  }
+
+  _c.col.resize(_c.ptr[n]);
+  _c.val.resize(_c.ptr[n]);
+
+  int*    c_col = _c.col.get_dataptr();
+  double* c_val = _c.val.get_dataptr();
+
+  mark.init(-1);
+
+  for (int i=0; i<n; i++)
+  {
+    int start = _c.ptr[i];
+    int pos   = start;
+
+    for (int ka=a_ptr[i]; ka<a_ptr[i+1]; ka++)
+    {
+      int    k = a_col[ka];
+      double v = a_val[ka];
+      for (int kb=b_ptr[k]; kb<b_ptr[k+1]; kb++)
+      {
+        int j = b_col[kb];
+        if (mark[j] < start)
+        {
+          mark[j]    = pos;
+          c_col[pos] = j;
+          c_val[pos] = v*b_val[kb];
+          pos++;
+        }
+        else
+          c_val[ mark[j] ] += v*b_val[kb];
+      }
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** Transponierte einer CSR-Matrix
+ *
+ */
+void Preconditioner_Multigrid::transpose(
+    CSR const&                    _a,                  // Matrix (i)
+    CSR&                          _t                   // Transponierte (o)
+    )
+{
+  int n = _a.num_rows;
+  int m = _a.num_cols;
+  int nnz = _a.ptr[n];
+
+  _t.num_rows = m;
+  _t.num_cols = n;
+  _t.ptr.resize(m+1);
+  _t.col.resize(nnz);
+  _t.val.resize(nnz);
+  _t.ptr.init();
+
+  for (int k=0; k<nnz; k++)
+    _t.ptr[ _a.col[k]+1 ]++;
+  for (int j=0; j<m; j++)
+    _t.ptr[j+1] += _t.ptr[j];
+
+  Array1D<int> pos(m);
+  for (int j=0; j<m; j++)
+    pos[j] = _t.ptr[j];
+
+  for (int i=0; i<n; i++)
+    for (int k=_a.ptr[i]; k<_a.ptr[i+1]; k++)
+    {
+      int p = pos[ _a.col[k] ]++;
+      _t.col[p] = i;
+      _t.val[p] = _a.val[k];
+    }
+
+  return;
+}
+
+
+
+
+/** Matrix-Vektor-Produkt y = A*x bzw. y = y + A*x
+ *
+ */
+void Preconditioner_Multigrid::mult(
+    CSR const&                    _a,                  // Matrix (i)
+    Array1D<double> const&        _x,                  // Vektor (i)
+    Array1D<double>&              _y,                  // Ergebnis (i/o)
+    bool                          _add                 // true: Ergebnis addieren (i)
+    )
+{
+  int    const* ptr = _a.ptr.get_dataptr();
+  int    const* col = _a.col.get_dataptr();
+  double const* val = _a.val.get_dataptr();
+  double const* x   = _x.get_dataptr();
+  double*       y   = _y.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<_a.num_rows; i++)
+  {
+    double sum = _add ? y[i] : 0.0;
+    for (int k=ptr[i]; k<ptr[i+1]; k++)
+      sum += val[k]*x[col[k]];
+    y[i] = sum;
+  }
+
+  return;
+}
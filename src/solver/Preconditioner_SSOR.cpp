@@ -0,0 +1,145 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Diagonale speichern, fuer MSR den Beginn des oberen
+ *  Dreiecks in jeder Zeile bestimmen
+ *
+ */
+void Preconditioner_SSOR::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  int n = _a.get_size();
+
+  a   = &_a;
+  msr = dynamic_cast<Matrix_MSR const*>(&_a);
+
+  diag.resize(n);
+  for (int i=0; i<n; i++)
+    diag[i] = _a.get_entry(i,i);
+
+  if (msr != NULL)
+  {
+    int const* idx = msr->get_index();
+
+    split.resize(n);
+    for (int i=0; i<n; i++)
+    {
+      int p = idx[i];
+      while (p < idx[i+1] && idx[p] < i)
+        p++;
+      split[i] = p;
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers
+ *  1. (D/omega + L) * y = in            (vorwaerts)
+ *  2. y = (2-omega)/omega * D * y
+ *  3. (D/omega + U) * out = y           (rueckwaerts)
+ *
+ */
+void Preconditioner_SSOR::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int n = diag.get_size();
+
+  double const* d   = diag.get_dataptr();
+  double const* in  = _in.get_dataptr();
+  double*       y   = _out.get_dataptr();
+  double        fac = (2.0 - omega) / omega;
+
+  if (msr != NULL)
+  {
+    double const* val = msr->get_value();
+    int    const* idx = msr->get_index();
+    int    const* sp  = split.get_dataptr();
+
+    // forward
+    for (int i=0; i<n; i++)
+    {
+      double sum = in[i];
+      for (int p=idx[i]; p<sp[i]; p++)
+        sum -= val[p] * y[idx[p]];
+      y[i] = omega * sum / d[i];
+    }
+
+    for (int i=0; i<n; i++)
+      y[i] *= fac * d[i];
+
+    // backward
+    for (int i=n-1; i>=0; i--)
+    {
+      double sum = y[i];
+      for (int p=sp[i]; p<idx[i+1]; p++)
+        sum -= val[p] * y[idx[p]];
+      y[i] = omega * sum / d[i];
+    }
+  }
+  else
+  {
+    // forward
+    for (int i=0; i<n; i++)
+    {
+      double sum = in[i];
+      for (int j=0; j<i; j++)
+        sum -= a->get_entry(i,j) * y[j];
+      y[i] = omega * sum / d[i];
+    }
+
+    for (int i=0; i<n; i++)
+      y[i] *= fac * d[i];
+
+    // backward
+    for (int i=n-1; i>=0; i--)
+    {
+      double sum = y[i];
+      for (int j=i+1; j<n; j++)
+        sum -= a->get_entry(i,j) * y[j];
+      y[i] = omega * sum / d[i];
+    }
+  }
+
+  return;
+}
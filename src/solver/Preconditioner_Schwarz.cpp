@@ -0,0 +1,639 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Discretization.h"
+#include "Solver.h"
+#include <algorithm>
+
+
+/** Konstruktor: Teilgebiete aus Knotenbloecken des strukturierten Netzes
+ *  Automatisch werden etwa 200 Knoten je Teilgebiet gewaehlt, die Aufteilung
+ *  in x und y folgt dem Seitenverhaeltnis des Netzes.
+ *
+ */
+Preconditioner_Schwarz::Preconditioner_Schwarz(
+    Discretization*               _dis,                // Zeiger auf die Diskretisierung (i)
+    int                           _sub_x,              // Teilgebiete in x-Richtung, 0: automatisch (i)
+    int                           _sub_y,              // Teilgebiete in y-Richtung, 0: automatisch (i)
+    int                           _overlap,            // Anzahl Ueberlappungsschichten (i)
+    bool                          _coarse              // Grobraumkorrektur (i)
+    )
+{
+  int nx = _dis->get_div_x() + 1;
+  int ny = _dis->get_div_y() + 1;
+
+  if ( _dis->node_get_size() != nx*ny )
+    throw runtime_error(string("Schwarz: discretization is not a structured mesh!!"));
+
+  if (_sub_x <= 0 || _sub_y <= 0)
+  {
+    int nsub = max(1, nx*ny/200);
+    _sub_y   = min(ny, max(1, (int) floor(sqrt(nsub*(double)ny/nx) + 0.5)));
+    _sub_x   = min(nx, max(1, (nsub + _sub_y - 1)/_sub_y));
+  }
+
+  num_sub       = _sub_x * _sub_y;
+  overlap       = _overlap;
+  coarse        = _coarse;
+  num_comp      = 2;
+  num_coarse    = 0;
+  num_z         = 0;
+  coarse_a      = NULL;
+  coarse_solver = NULL;
+
+  int n = _dis->get_num_dof_solve();
+  part.resize(n);
+  comp.resize(n);
+  rot.resize(n);
+
+  // Schwerpunkte der Teilgebiete (Knoten mit freien Freiheitsgraden)
+  Array1D<double> xc(num_sub);
+  Array1D<double> yc(num_sub);
+  Array1D<int>    cnt(num_sub);
+  xc.init();
+  yc.init();
+  cnt.init();
+
+  for (int k=0; k<_dis->node_get_size(); k++)
+  {
+    Node &act_node = *_dis->node_get(k);
+    if ( act_node.get_bc_displ(0) && act_node.get_bc_displ(1) )
+      continue;
+
+    int s = (k % nx) * _sub_x / nx + _sub_x * ((k / nx) * _sub_y / ny);
+    xc[s] += act_node.get_x();
+    yc[s] += act_node.get_y();
+    cnt[s]++;
+  }
+
+  for (int k=0; k<_dis->node_get_size(); k++)
+  {
+    Node &act_node = *_dis->node_get(k);
+
+    int s = (k % nx) * _sub_x / nx + _sub_x * ((k / nx) * _sub_y / ny);
+
+    for (int j=0; j<2; j++)
+    {
+      if (act_node.get_bc_displ(j))
+        continue;
+
+      int d   = act_node.dof_get(j);
+      part[d] = s;
+      comp[d] = j;
+      rot[d]  = (j == 0) ? -(act_node.get_y() - yc[s]/cnt[s])
+                         :  (act_node.get_x() - xc[s]/cnt[s]);
+    }
+  }
+}
+
+
+
+
+/** Konstruktor: num_sub zusammenhaengende Bereiche der Freiheitsgrade
+ *  Die Einteilung erfolgt in setup, wenn die Groesse der Matrix bekannt ist.
+ *
+ */
+Preconditioner_Schwarz::Preconditioner_Schwarz(
+    int                           _num_sub,            // Anzahl Teilgebiete (i)
+    int                           _overlap,            // Anzahl Ueberlappungsschichten (i)
+    bool                          _coarse              // Grobraumkorrektur (i)
+    )
+{
+  num_sub       = max(1, _num_sub);
+  overlap       = _overlap;
+  coarse        = _coarse;
+  num_comp      = 1;
+  num_coarse    = 0;
+  num_z         = 0;
+  coarse_a      = NULL;
+  coarse_solver = NULL;
+}
+
+
+
+
+Preconditioner_Schwarz::~Preconditioner_Schwarz()
+{
+  cleanup();
+}
+
+
+
+
+/** Loeschen der Grobraum-Faktorisierung
+ *
+ */
+void Preconditioner_Schwarz::cleanup()
+{
+  delete coarse_a;
+  delete coarse_solver;
+  coarse_a      = NULL;
+  coarse_solver = NULL;
+  num_coarse    = 0;
+  num_z         = 0;
+
+  return;
+}
+
+
+
+
+/** Vorbereitung: Teilgebiete aufstellen und faktorisieren, ggf. Grobraum
+ *
+ */
+void Preconditioner_Schwarz::setup(
+    Matrix const&                 _a                   // Matrix des LGS (i)
+    )
+{
+  Matrix_MSR const* a = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (a == NULL)
+    throw runtime_error(string("Schwarz: only implemented for Matrix_MSR!!"));
+
+  int n = a->get_size();
+
+  // ohne Diskretisierung: gleich grosse Bereiche der Freiheitsgrade
+  if (num_comp == 1 && part.get_size() != n)
+  {
+    part.resize(n);
+    comp.resize(n);
+    for (int i=0; i<n; i++)
+    {
+      part[i] = (int) ((long) i * num_sub / n);
+      comp[i] = 0;
+    }
+  }
+
+  if (part.get_size() != n)
+    throw runtime_error(string("Schwarz: matrix does not match the discretization!!"));
+
+  cleanup();
+
+  setup_subdomains(*a);
+
+  if (coarse)
+    setup_coarse(*a);
+
+  int max_size = 0;
+  for (int s=0; s<num_sub; s++)
+    max_size = max(max_size, sub_ptr[s+1] - sub_ptr[s]);
+
+  printf("Schwarz: %d subdomains, overlap %d, local size %d (max %d), factor %d entries, coarse space %d\n",
+      num_sub, overlap, sub_ptr[num_sub]/num_sub, max_size, env_val.get_size(), num_coarse);
+
+  return;
+}
+
+
+
+
+/** Cholesky-Zerlegung A_s = L*L^T in der Huelle
+ *  Zeile i von L ist von Spalte first[i] bis i besetzt (L[i] zeigt auf die
+ *  Spalte first[i]); Auffuellen bleibt innerhalb der Huelle.
+ *  Rueckgabe false, falls A_s nicht positiv definit ist.
+ *
+ */
+static bool factor_envelope(
+    int                           _m,                  // Anzahl Zeilen (i)
+    int const*                    _first,              // erste Spalte je Zeile (i)
+    int const*                    _start,              // Anfang der Zeile in val (i)
+    double*                       _val                 // Eintraege von A_s, danach L (i/o)
+    )
+{
+  for (int i=0; i<_m; i++)
+  {
+    double* l_i = _val + _start[i] - _first[i];
+
+    for (int j=_first[i]; j<=i; j++)
+    {
+      double const* l_j = _val + _start[j] - _first[j];
+
+      double sum = l_i[j];
+      for (int k=max(_first[i], _first[j]); k<j; k++)
+        sum -= l_i[k] * l_j[k];
+
+      if (j < i)
+        l_i[j] = sum / l_j[j];
+      else if (sum > 0.0)
+        l_i[i] = sqrt(sum);
+      else
+        return false;
+    }
+  }
+
+  return true;
+}
+
+
+
+
+/** Loesung L*L^T*x = b in der Huelle, x ueberschreibt b
+ *
+ */
+static void solve_envelope(
+    int                           _m,                  // Anzahl Zeilen (i)
+    int const*                    _first,              // erste Spalte je Zeile (i)
+    int const*                    _start,              // Anfang der Zeile in val (i)
+    double const*                 _val,                // L (i)
+    double*                       _x                   // rechte Seite b, Loesung x (i/o)
+    )
+{
+  // forward
+  for (int i=0; i<_m; i++)
+  {
+    double const* l_i = _val + _start[i] - _first[i];
+    double sum = _x[i];
+    for (int k=_first[i]; k<i; k++)
+      sum -= l_i[k] * _x[k];
+    _x[i] = sum / l_i[i];
+  }
+
+  // backward, L^T ueber die Zeilen von L
+  for (int i=_m-1; i>=0; i--)
+  {
+    double const* l_i = _val + _start[i] - _first[i];
+    _x[i] /= l_i[i];
+    double x_i = _x[i];
+    for (int k=_first[i]; k<i; k++)
+      _x[k] -= l_i[k] * x_i;
+  }
+
+  return;
+}
+
+
+
+
+/** Freiheitsgrade der Teilgebiete mit Ueberlappung, lokale Matrizen und
+ *  deren Faktorisierung; die Teilgebiete werden parallel bearbeitet.
+ *
+ */
+void Preconditioner_Schwarz::setup_subdomains(
+    Matrix_MSR const&             _a                   // Matrix des LGS (i)
+    )
+{
+  int           n     = _a.get_size();
+  int const*    index = _a.get_index();
+  double const* value = _a.get_value();
+
+
+  // Kerne der Teilgebiete (ohne Ueberlappung), nach Teilgebieten sortiert
+  Array1D<int> core_ptr(num_sub+1);
+  Array1D<int> core(n);
+
+  core_ptr.init();
+  for (int i=0; i<n; i++)
+    core_ptr[ part[i]+1 ]++;
+  for (int s=0; s<num_sub; s++)
+    core_ptr[s+1] += core_ptr[s];
+  {
+    Array1D<int> next(num_sub);
+    for (int s=0; s<num_sub; s++)
+      next[s] = core_ptr[s];
+    for (int i=0; i<n; i++)
+      core[ next[part[i]]++ ] = i;
+  }
+
+
+  // Ueberlappung: overlap Schichten von Nachbarn im Matrixgraphen
+  Array1D< Array1D<int> > dofs(num_sub);
+  Array1D<int>            num_dofs(num_sub);
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int s=0; s<num_sub; s++)
+  {
+    int m = core_ptr[s+1] - core_ptr[s];
+    Array1D<int> cur(max(m, 1));
+    for (int k=0; k<m; k++)
+      cur[k] = core[ core_ptr[s] + k ];
+
+    for (int layer=0; layer<overlap; layer++)
+    {
+      int len = m;
+      for (int k=0; k<m; k++)
+        len += index[cur[k]+1] - index[cur[k]];
+
+      Array1D<int> next(max(len, 1));
+      int*         np = next.get_dataptr();
+      int          c  = 0;
+      for (int k=0; k<m; k++)
+      {
+        np[c++] = cur[k];
+        for (int l=index[cur[k]]; l<index[cur[k]+1]; l++)
+          np[c++] = index[l];
+      }
+
+      std::sort(np, np+c);
+      m   = (int) (std::unique(np, np+c) - np);
+      cur = next;
+    }
+
+    dofs[s]     = cur;
+    num_dofs[s] = m;
+  }
+
+
+  sub_ptr.resize(num_sub+1);
+  sub_ptr[0] = 0;
+  for (int s=0; s<num_sub; s++)
+    sub_ptr[s+1] = sub_ptr[s] + num_dofs[s];
+
+  int num_pos = sub_ptr[num_sub];
+  sub_dof.resize(num_pos);
+  for (int s=0; s<num_sub; s++)
+    for (int k=0; k<num_dofs[s]; k++)
+      sub_dof[ sub_ptr[s]+k ] = dofs[s][k];
+
+
+  // Umkehrung: an welchen Positionen von sub_dof steht ein Freiheitsgrad
+  dof_ptr.resize(n+1);
+  dof_ptr.init();
+  for (int p=0; p<num_pos; p++)
+    dof_ptr[ sub_dof[p]+1 ]++;
+  for (int i=0; i<n; i++)
+    dof_ptr[i+1] += dof_ptr[i];
+
+  dof_pos.resize(dof_ptr[n]);
+  {
+    Array1D<int> next(n);
+    for (int i=0; i<n; i++)
+      next[i] = dof_ptr[i];
+    for (int p=0; p<num_pos; p++)
+      dof_pos[ next[sub_dof[p]]++ ] = p;
+  }
+
+
+  // Huelle der lokalen Matrizen: erste lokale Spalte je Zeile
+  env_first.resize(num_pos);
+  env_start.resize(num_pos+1);
+
+  int const* sd = sub_dof.get_dataptr();
+  int*       ef = env_first.get_dataptr();
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int s=0; s<num_sub; s++)
+  {
+    int        m   = num_dofs[s];
+    int const* dof = sd + sub_ptr[s];
+
+    for (int k=0; k<m; k++)
+    {
+      int first = k;
+      int g     = dof[k];
+      for (int l=index[g]; l<index[g+1] && index[l] < g; l++)
+      {
+        int const* pos = std::lower_bound(dof, dof+k, index[l]);
+        if (pos != dof+k && *pos == index[l])
+        {
+          first = (int) (pos - dof);
+          break;
+        }
+      }
+      ef[ sub_ptr[s]+k ] = first;
+    }
+  }
+
+  // Zeilenlaenge k - first + 1, lokale Nummer k = p - sub_ptr[s]
+  env_start[0] = 0;
+  for (int s=0; s<num_sub; s++)
+    for (int p=sub_ptr[s]; p<sub_ptr[s+1]; p++)
+      env_start[p+1] = env_start[p] + (p - sub_ptr[s]) - ef[p] + 1;
+
+
+  // Eintraege von A_s in die Huelle kopieren und faktorisieren
+  env_val.resize(env_start[num_pos]);
+  env_val.init();
+
+  int*    es     = env_start.get_dataptr();
+  double* ev     = env_val.get_dataptr();
+  bool    failed = false;
+
+  #pragma omp parallel for schedule(dynamic) reduction(||:failed)
+  for (int s=0; s<num_sub; s++)
+  {
+    int        m   = num_dofs[s];
+    int        p0  = sub_ptr[s];
+    int const* dof = sd + p0;
+
+    for (int k=0; k<m; k++)
+    {
+      int     g   = dof[k];
+      double* l_k = ev + es[p0+k] - ef[p0+k];
+
+      l_k[k] = value[g];
+      for (int l=index[g]; l<index[g+1] && index[l] < g; l++)
+      {
+        int const* pos = std::lower_bound(dof, dof+k, index[l]);
+        if (pos != dof+k && *pos == index[l])
+          l_k[pos - dof] = value[l];
+      }
+    }
+
+    if (!factor_envelope(m, ef + p0, es + p0, ev))
+      failed = true;
+  }
+
+  if (failed)
+    throw runtime_error(string("Schwarz: local matrix not positive definite!!"));
+
+  loc.resize(num_pos);
+
+  return;
+}
+
+
+
+
+/** Grobraum Z: je Teilgebiet die Starrkoerperbewegungen des Kerns
+ *  (Verschiebung je Richtung, mit Diskretisierung zusaetzlich die Drehung);
+ *  A0 = Z^T*A*Z wird dicht aufgestellt und mit Solver_Cholesky faktorisiert.
+ *
+ */
+void Preconditioner_Schwarz::setup_coarse(
+    Matrix_MSR const&             _a                   // Matrix des LGS (i)
+    )
+{
+  int           n     = _a.get_size();
+  int const*    index = _a.get_index();
+  double const* value = _a.get_value();
+
+  bool rotation = (num_comp == 2);
+  num_z = rotation ? 2 : 1;
+
+  // nur belegte Spalten verwenden
+  int          stride = num_comp + (rotation ? 1 : 0);
+  Array1D<int> col_id(num_sub*stride);
+  col_id.init(-1);
+  num_coarse = 0;
+
+  z_col.resize(num_z*n);
+  z_val.resize(num_z*n);
+  for (int i=0; i<n; i++)
+  {
+    int c = part[i]*stride + comp[i];
+    if (col_id[c] < 0)
+      col_id[c] = num_coarse++;
+    z_col[num_z*i] = col_id[c];
+    z_val[num_z*i] = 1.0;
+
+    if (rotation)
+    {
+      c = part[i]*stride + num_comp;
+      if (col_id[c] < 0)
+        col_id[c] = num_coarse++;
+      z_col[num_z*i+1] = col_id[c];
+      z_val[num_z*i+1] = rot[i];
+    }
+  }
+
+  Array2D<double> a0(num_coarse, num_coarse);
+  a0.init();
+
+  int    const* zc = z_col.get_dataptr();
+  double const* zv = z_val.get_dataptr();
+
+  for (int i=0; i<n; i++)
+  {
+    for (int a=0; a<num_z; a++)
+    {
+      double* row = a0[ zc[num_z*i+a] ];
+      double  wa  = zv[num_z*i+a];
+
+      for (int b=0; b<num_z; b++)
+        row[ zc[num_z*i+b] ] += wa * value[i] * zv[num_z*i+b];
+
+      for (int l=index[i]; l<index[i+1]; l++)
+      {
+        int j = index[l];
+        for (int b=0; b<num_z; b++)
+          row[ zc[num_z*j+b] ] += wa * value[l] * zv[num_z*j+b];
+      }
+    }
+  }
+
+  // dicht besetzt als CSR
+  Array1D<int>    ptr(num_coarse+1);
+  Array1D<int>    col(num_coarse*num_coarse);
+  Array1D<double> val(num_coarse*num_coarse);
+  for (int r=0; r<num_coarse; r++)
+  {
+    ptr[r] = r*num_coarse;
+    for (int c=0; c<num_coarse; c++)
+    {
+      col[r*num_coarse+c] = c;
+      val[r*num_coarse+c] = a0[r][c];
+    }
+  }
+  ptr[num_coarse] = num_coarse*num_coarse;
+
+  coarse_a      = new Matrix_MSR(num_coarse, ptr.get_dataptr(), col.get_dataptr(), val.get_dataptr());
+  coarse_solver = new Solver_Cholesky();
+  coarse_solver->factorize(*coarse_a);
+
+  coarse_f.resize(num_coarse);
+  coarse_u.resize(num_coarse);
+
+  return;
+}
+
+
+
+
+/** Anwendung des Vorkonditionierers
+ *  1. lokale Loesungen A_s^-1*R_s*in, parallel ueber die Teilgebiete
+ *  2. Grobraumloesung A0^-1*Z^T*in
+ *  3. out = Z*u0 + sum_s R_s^T*u_s, parallel ueber die Freiheitsgrade
+ *
+ */
+void Preconditioner_Schwarz::apply(
+    Array1D<double> const&        _in,                 // Eingangsvektor, z.B. Residuum (i)
+    Array1D<double>&              _out                 // vorkonditionierter Vektor (o)
+    ) const
+{
+  int n = _in.get_size();
+
+  double const* in  = _in.get_dataptr();
+  double*       out = _out.get_dataptr();
+  int    const* sd  = sub_dof.get_dataptr();
+  int    const* sp  = sub_ptr.get_dataptr();
+  int    const* dp  = dof_ptr.get_dataptr();
+  int    const* pos = dof_pos.get_dataptr();
+  int    const* ef  = env_first.get_dataptr();
+  int    const* es  = env_start.get_dataptr();
+  double const* ev  = env_val.get_dataptr();
+  double*       lp  = loc.get_dataptr();
+
+
+  #pragma omp parallel for schedule(dynamic)
+  for (int s=0; s<num_sub; s++)
+  {
+    for (int p=sp[s]; p<sp[s+1]; p++)
+      lp[p] = in[ sd[p] ];
+
+    solve_envelope(sp[s+1]-sp[s], ef + sp[s], es + sp[s], ev, lp + sp[s]);
+  }
+
+
+  double const* cu = NULL;
+  int    const* zc = z_col.get_dataptr();
+  double const* zv = z_val.get_dataptr();
+
+  if (coarse)
+  {
+    double* cf = coarse_f.get_dataptr();
+
+    coarse_f.init();
+    for (int i=0; i<n; i++)
+      for (int a=0; a<num_z; a++)
+        cf[ zc[num_z*i+a] ] += zv[num_z*i+a] * in[i];
+
+    coarse_solver->solve(coarse_u, coarse_f);
+    cu = coarse_u.get_dataptr();
+  }
+
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double sum = 0.0;
+    if (cu != NULL)
+      for (int a=0; a<num_z; a++)
+        sum += zv[num_z*i+a] * cu[ zc[num_z*i+a] ];
+
+    for (int q=dp[i]; q<dp[i+1]; q++)
+      sum += lp[ pos[q] ];
+    out[i] = sum;
+  }
+
+  return;
+}
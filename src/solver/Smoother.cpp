@@ -0,0 +1,114 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Erzeugt einen Glaetter des gegebenen Typs mit Standardparametern
+ *
+ */
+Smoother* Smoother::create(
+    Smoother_Type                 _type                // Typ des Glaetters (i)
+    )
+{
+  switch (_type)
+  {
+    case SMOOTHER_JACOBI:
+      return new Smoother_Jacobi();
+    case SMOOTHER_CHEBYSHEV:
+      return new Smoother_Chebyshev();
+    case SMOOTHER_GAUSS_SEIDEL:
+      return new Smoother_GaussSeidel();
+  }
+
+  throw runtime_error(string("Smoother: unknown type!!"));
+}
+
+
+
+
+/** Schaetzung des groessten Eigenwerts von D^-1*A mit der Potenzmethode
+ *
+ */
+double Smoother::estimate_lambda_max(
+    Matrix_MSR const&             _a,                  // Matrix (i)
+    Array1D<double> const&        _diag_inv,           // Inverse der Diagonalen (i)
+    int                           _ite                 // Anzahl Iterationen (i)
+    )
+{
+  int n = _a.get_size();
+
+  Array1D<double> x(n);
+  Array1D<double> y(n);
+
+  double*       xp = x.get_dataptr();
+  double*       yp = y.get_dataptr();
+  double const* di = _diag_inv.get_dataptr();
+
+  // Startvektor mit Pseudo-Zufallszahlen, damit auch die hochfrequenten
+  // Anteile (groesste Eigenwerte) von Anfang an enthalten sind
+  unsigned int seed = 12345;
+  for (int i=0; i<n; i++)
+  {
+    seed  = 1103515245u*seed + 12345u;
+    xp[i] = (double)(seed >> 16) / 65536.0 - 0.5;
+  }
+
+  double lambda = 0.0;
+
+  for (int k=0; k<_ite; k++)
+  {
+    double norm_x = 0.0;
+    for (int i=0; i<n; i++)
+      norm_x += xp[i]*xp[i];
+    norm_x = sqrt(norm_x);
+
+    _a.mult(x, y);
+
+    double norm_y = 0.0;
+    for (int i=0; i<n; i++)
+    {
+      yp[i] *= di[i];
+      norm_y += yp[i]*yp[i];
+    }
+    norm_y = sqrt(norm_y);
+
+    lambda = norm_y / norm_x;
+
+    for (int i=0; i<n; i++)
+      xp[i] = yp[i] / norm_y;
+  }
+
+  return lambda;
+}
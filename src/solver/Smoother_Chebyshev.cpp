@@ -0,0 +1,122 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Inverse der Diagonalen und Intervall des Polynoms bestimmen
+ *
+ */
+void Smoother_Chebyshev::setup(
+    Matrix_MSR const&             _a                   // Matrix des Levels (i)
+    )
+{
+  int n = _a.get_size();
+
+  a = &_a;
+  diag_inv.resize(n);
+  res.resize(n);
+  d.resize(n);
+
+  for (int i=0; i<n; i++)
+    diag_inv[i] = 1.0 / _a.get_value()[i];
+
+  // lambda_max von D^-1*A aus einigen CG/Lanczos-Schritten, Lanczos
+  // unterschaetzt lambda_max leicht, daher Sicherheitsfaktor
+  Preconditioner_Jacobi jacobi;
+  double                lambda_low;
+
+  jacobi.setup(_a);
+  Solver_CG::estimate_bounds(_a, jacobi, 10, lambda_low, lambda_max);
+  lambda_max *= 1.1;
+  lambda_min  = lambda_max / ratio;
+
+  return;
+}
+
+
+
+
+/** Glaettung mit der Chebyshev-Iteration (vorkonditioniert mit D^-1)
+ *  Es werden degree Korrekturen berechnet, ohne Skalarprodukte.
+ *
+ */
+void Smoother_Chebyshev::smooth(
+    Array1D<double> const&        _b,                  // rechte Seite (i)
+    Array1D<double>&              _x                   // Naeherung (i/o)
+    )
+{
+  int n = a->get_size();
+
+  double const* b  = _b.get_dataptr();
+  double*       x  = _x.get_dataptr();
+  double*       r  = res.get_dataptr();
+  double*       dp = d.get_dataptr();
+  double const* di = diag_inv.get_dataptr();
+
+  double theta = 0.5 * (lambda_max + lambda_min);
+  double delta = 0.5 * (lambda_max - lambda_min);
+  double sigma = theta / delta;
+  double rho   = 1.0 / sigma;
+
+  a->mult(_x, res);
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+    dp[i] = di[i] * (b[i] - r[i]) / theta;
+
+  for (int k=0; k<degree; k++)
+  {
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      x[i] += dp[i];
+
+    if (k == degree-1)
+      break;
+
+    a->mult(_x, res);
+
+    double rho_new = 1.0 / (2.0*sigma - rho);
+    double c1      = rho_new * rho;
+    double c2      = 2.0 * rho_new / delta;
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      dp[i] = c1 * dp[i] + c2 * di[i] * (b[i] - r[i]);
+
+    rho = rho_new;
+  }
+
+  return;
+}
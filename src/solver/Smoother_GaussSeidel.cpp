@@ -0,0 +1,125 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Faerbung der Zeilen und Inverse der Diagonalen
+ *
+ */
+void Smoother_GaussSeidel::setup(
+    Matrix_MSR const&             _a                   // Matrix des Levels (i)
+    )
+{
+  int n = _a.get_size();
+
+  if (omega <= 0.0 || omega >= 2.0)
+    throw runtime_error(string("GaussSeidel: omega must be in (0,2)!!"));
+
+  a = &_a;
+  diag_inv.resize(n);
+
+  for (int i=0; i<n; i++)
+    diag_inv[i] = 1.0 / _a.get_value()[i];
+
+  num_colors = _a.color_rows(color_ptr, rows);
+
+  return;
+}
+
+
+
+
+/** Ein SOR-Durchlauf ueber alle Farben, vorwaerts oder rueckwaerts
+ *  Innerhalb einer Farbe haengen die Zeilen nicht voneinander ab, daher
+ *  ist das Ergebnis unabhaengig von der Anzahl der Threads.
+ *  Rueckgabe ist das Quadrat der Norm der Aenderung von x.
+ *
+ */
+double Smoother_GaussSeidel::sweep(
+    Array1D<double> const&        _b,                  // rechte Seite (i)
+    Array1D<double>&              _x,                  // Naeherung (i/o)
+    bool                          _backward            // Reihenfolge der Farben umkehren (i)
+    )
+{
+  double const* val = a->get_value();
+  int    const* idx = a->get_index();
+  double const* b   = _b.get_dataptr();
+  double*       x   = _x.get_dataptr();
+  double const* di  = diag_inv.get_dataptr();
+  int    const* row = rows.get_dataptr();
+  int    const* cp  = color_ptr.get_dataptr();
+
+  double du2 = 0.0;
+
+  for (int cc=0; cc<num_colors; cc++)
+  {
+    int c = _backward ? num_colors-1-cc : cc;
+
+    #pragma omp parallel for reduction(+:du2) schedule(static)
+    for (int k=cp[c]; k<cp[c+1]; k++)
+    {
+      int    i   = row[k];
+      double sum = b[i];
+      for (int j=idx[i]; j<idx[i+1]; j++)
+        sum -= val[j] * x[ idx[j] ];
+
+      double d = omega * (sum*di[i] - x[i]);
+      x[i] += d;
+      du2  += d*d;
+    }
+  }
+
+  return du2;
+}
+
+
+
+
+/** Glaettung: symmetrische Durchlaeufe vorwaerts und rueckwaerts
+ *
+ */
+void Smoother_GaussSeidel::smooth(
+    Array1D<double> const&        _b,                  // rechte Seite (i)
+    Array1D<double>&              _x                   // Naeherung (i/o)
+    )
+{
+  for (int s=0; s<sweeps; s++)
+  {
+    sweep(_b, _x, false);
+    sweep(_b, _x, true);
+  }
+
+  return;
+}
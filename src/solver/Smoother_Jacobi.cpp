@@ -0,0 +1,90 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Inverse der Diagonalen und Daempfung bestimmen
+ *
+ */
+void Smoother_Jacobi::setup(
+    Matrix_MSR const&             _a                   // Matrix des Levels (i)
+    )
+{
+  int n = _a.get_size();
+
+  a = &_a;
+  diag_inv.resize(n);
+  res.resize(n);
+
+  for (int i=0; i<n; i++)
+    diag_inv[i] = 1.0 / _a.get_value()[i];
+
+  if (omega > 0.0)
+    omega_used = omega;
+  else
+    omega_used = 4.0 / (3.0 * estimate_lambda_max(_a, diag_inv));
+
+  return;
+}
+
+
+
+
+/** Glaettung: x = x + omega * D^-1 * (b - a*x)
+ *
+ */
+void Smoother_Jacobi::smooth(
+    Array1D<double> const&        _b,                  // rechte Seite (i)
+    Array1D<double>&              _x                   // Naeherung (i/o)
+    )
+{
+  int n = a->get_size();
+
+  double const* b  = _b.get_dataptr();
+  double*       x  = _x.get_dataptr();
+  double*       r  = res.get_dataptr();
+  double const* di = diag_inv.get_dataptr();
+
+  for (int s=0; s<sweeps; s++)
+  {
+    a->mult(_x, res);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      x[i] += omega_used * di[i] * (b[i] - r[i]);
+  }
+
+  return;
+}
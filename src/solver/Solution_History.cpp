@@ -0,0 +1,213 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Speichern einer Loesung, die aelteste wird ggf. ueberschrieben
+ *
+ */
+void Solution_History::add(
+    Array1D<double> const&        _u                   // Loesung (i)
+    )
+{
+  Array1D<double>& slot = hist[head];
+
+  if (slot.get_size() != _u.get_size())
+    slot = Array1D<double>(_u.get_size());
+
+  int n = _u.get_size();
+  double*       s = slot.get_dataptr();
+  double const* u = _u.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+    s[i] = u[i];
+
+  head = (head + 1) % depth;
+  num  = min(num + 1, depth);
+
+  return;
+}
+
+
+
+
+/** Polynomiale Extrapolation auf den naechsten Schritt
+ *  Der Grad wird auf die Anzahl gespeicherter Loesungen - 1 begrenzt,
+ *  ohne gespeicherte Loesung ist u = 0.
+ *
+ */
+void Solution_History::extrapolate(
+    Array1D<double>&              _u,                  // Startwert (o)
+    int                           _order               // Grad des Polynoms (i)
+    ) const
+{
+  int n = _u.get_size();
+  int p = min(_order, num - 1);
+
+  double* u = _u.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+    u[i] = 0.0;
+
+  // c_j = (-1)^j * (p+1 ueber j+1)
+  double binom = p + 1;
+  for (int j=0; j<=p; j++)
+  {
+    double        c = (j % 2 == 0) ? binom : -binom;
+    double const* x = get_solution(j).get_dataptr();
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      u[i] += c * x[i];
+
+    binom = binom * (p - j) / (j + 2);
+  }
+
+  return;
+}
+
+
+
+
+/** Galerkin-Projektion von A*u=f auf den Raum der gespeicherten Loesungen
+ *  Die Loesungen werden mit modifiziertem Gram-Schmidt A-orthonormiert
+ *  (q_i^T*A*q_j = delta_ij), linear abhaengige werden verworfen.
+ *  Dann ist u = sum_i (q_i^T*f) * q_i.
+ *
+ */
+void Solution_History::project(
+    Matrix const&                 _a,                  // Matrix des LGS (i)
+    Array1D<double> const&        _f,                  // rechte Seite (i)
+    Array1D<double>&              _u                   // Startwert (o)
+    ) const
+{
+  int n = _u.get_size();
+  double* u = _u.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+    u[i] = 0.0;
+
+  Array1D< Array1D<double> > q(num);                   // A-orthonormale Basis
+  Array1D< Array1D<double> > aq(num);                  // A*q
+  int m = 0;
+
+  for (int k=0; k<num; k++)
+  {
+    Array1D<double>& v  = q[m];
+    Array1D<double>& av = aq[m];
+    v  = get_solution(k);
+    av = Array1D<double>(n);
+    _a.mult(v, av);
+
+    double*       vp    = v.get_dataptr();
+    double*       avp   = av.get_dataptr();
+    double        norm0 = Solver::dot(v, av);
+
+    for (int j=0; j<m; j++)
+    {
+      double        c   = Solver::dot(q[j], av);
+      double const* qj  = q[j].get_dataptr();
+      double const* aqj = aq[j].get_dataptr();
+
+      #pragma omp parallel for schedule(static)
+      for (int i=0; i<n; i++)
+      {
+        vp[i]  -= c * qj[i];
+        avp[i] -= c * aqj[i];
+      }
+    }
+
+    // (fast) linear abhaengig von den bisherigen: verwerfen
+    double norm = Solver::dot(v, av);
+    if (norm <= 1e-12 * norm0 || norm0 <= 0.0)
+      continue;
+
+    double s = 1.0 / sqrt(norm);
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      vp[i]  *= s;
+      avp[i] *= s;
+    }
+    m++;
+  }
+
+  for (int j=0; j<m; j++)
+  {
+    double        c  = Solver::dot(q[j], _f);
+    double const* qj = q[j].get_dataptr();
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      u[i] += c * qj[i];
+  }
+
+  return;
+}
+
+
+
+
+/** Startwert fuer den naechsten solve
+ *
+ */
+void Solution_History::guess(
+    Guess_Type                    _type,               // Art des Startwerts (i)
+    Matrix const&                 _a,                  // Matrix des LGS (i)
+    Array1D<double> const&        _f,                  // rechte Seite (i)
+    Array1D<double>&              _u                   // Startwert (o)
+    ) const
+{
+  switch (_type)
+  {
+    case GUESS_ZERO:
+      _u.init();
+      break;
+    case GUESS_PREVIOUS:
+      extrapolate(_u, 0);
+      break;
+    case GUESS_EXTRAPOLATE:
+      extrapolate(_u, 2);
+      break;
+    case GUESS_PROJECTION:
+      project(_a, _f, _u);
+      break;
+  }
+
+  return;
+}
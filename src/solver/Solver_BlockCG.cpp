@@ -0,0 +1,424 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Groesse eines Blocks setzen, der Inhalt wird nicht erhalten
+ *
+ */
+static void set_size(
+    Array2D<double>&              _a,                  // Block (i/o)
+    int                           _n,                  // Anzahl Zeilen (i)
+    int                           _s                   // Anzahl Spalten (i)
+    )
+{
+  if (_a.get_size_1() != _n || _a.get_size_2() != _s)
+    _a.resize(_n, _s);
+
+  return;
+}
+
+
+
+
+/** Block-Skalarprodukt g = a^T * b
+ *
+ */
+static void block_dot(
+    Array2D<double> const&        _a,                  // linker Block, n x sa (i)
+    Array2D<double> const&        _b,                  // rechter Block, n x sb (i)
+    Array2D<double>&              _g                   // Ergebnis, sa x sb (o)
+    )
+{
+  int n  = _a.get_size_1();
+  int sa = _a.get_size_2();
+  int sb = _b.get_size_2();
+
+  set_size(_g, sa, sb);
+
+  double* g = new double[sa*sb];
+  for (int k=0; k<sa*sb; k++)
+    g[k] = 0.0;
+
+  #pragma omp parallel for reduction(+:g[:sa*sb]) schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double const* a_i = _a[i];
+    double const* b_i = _b[i];
+    for (int k=0; k<sa; k++)
+      for (int l=0; l<sb; l++)
+        g[k*sb+l] += a_i[k]*b_i[l];
+  }
+
+  for (int k=0; k<sa; k++)
+    for (int l=0; l<sb; l++)
+      _g[k][l] = g[k*sb+l];
+
+  delete[] g;
+
+  return;
+}
+
+
+
+
+/** Block-Update c = c - a*m
+ *
+ */
+static void block_update(
+    Array2D<double>&              _c,                  // Block, n x sb (i/o)
+    Array2D<double> const&        _a,                  // Block, n x sa (i)
+    Array2D<double> const&        _m                   // kleine Matrix, sa x sb (i)
+    )
+{
+  int n  = _a.get_size_1();
+  int sa = _a.get_size_2();
+  int sb = _m.get_size_2();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double const* a_i = _a[i];
+    double*       c_i = _c[i];
+    for (int l=0; l<sb; l++)
+    {
+      double sum = 0.0;
+      for (int k=0; k<sa; k++)
+        sum += a_i[k]*_m[k][l];
+      c_i[l] -= sum;
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** Vorkonditionierer spaltenweise auf einen Block anwenden: z = M*r
+ *
+ */
+static void block_precond(
+    Preconditioner const&         _precond,            // Vorkonditionierer (i)
+    Array2D<double> const&        _r,                  // Block (i)
+    Array2D<double>&              _z,                  // Ergebnis (o)
+    Array1D<double>&              _in,                 // Arbeitsvektor (-)
+    Array1D<double>&              _out                 // Arbeitsvektor (-)
+    )
+{
+  int n = _r.get_size_1();
+  int s = _r.get_size_2();
+
+  set_size(_z, n, s);
+
+  double* in  = _in.get_dataptr();
+  double* out = _out.get_dataptr();
+
+  for (int c=0; c<s; c++)
+  {
+    for (int i=0; i<n; i++)
+      in[i] = _r[i][c];
+
+    _precond.apply(_in, _out);
+
+    for (int i=0; i<n; i++)
+      _z[i][c] = out[i];
+  }
+
+  return;
+}
+
+
+
+
+/** Orthonormierung der Spalten von x im Skalarprodukt <a,b> = a^T*B*b
+ *  y = B*x wird mitgefuehrt und genauso transformiert. Gram-Schmidt mit
+ *  zweitem Durchlauf direkt auf den Vektoren, nicht ueber die Gram-Matrix,
+ *  da sich deren Kondition gegenueber x quadriert.
+ *  Spalten, deren verbleibende Norm^2 kleiner als abs_tol2 bzw. rel_tol2 mal
+ *  der urspruenglichen Norm^2 ist, werden entfernt.
+ *  Rueckgabe ist die Anzahl der verbleibenden Spalten.
+ *
+ */
+static int orthonormalize(
+    Array2D<double>&              _x,                  // Block (i/o)
+    Array2D<double>&              _y,                  // B * Block (i/o)
+    double                        _abs_tol2,           // absolute Schranke fuer Norm^2 (i)
+    double                        _rel_tol2            // relative Schranke fuer Norm^2 (i)
+    )
+{
+  int n = _x.get_size_1();
+  int s = _x.get_size_2();
+
+  Array1D<int> kept(s);
+  int          num_kept = 0;
+  int*         kp       = kept.get_dataptr();
+  double*      c        = new double[s];
+
+  for (int k=0; k<s; k++)
+  {
+    double norm0 = 0.0;
+    #pragma omp parallel for reduction(+:norm0) schedule(static)
+    for (int i=0; i<n; i++)
+      norm0 += _x[i][k]*_y[i][k];
+
+    // zwei Durchlaeufe klassisches Gram-Schmidt gegen alle bisherigen Spalten
+    for (int pass=0; pass<2 && num_kept>0; pass++)
+    {
+      for (int a=0; a<num_kept; a++)
+        c[a] = 0.0;
+
+      #pragma omp parallel for reduction(+:c[:num_kept]) schedule(static)
+      for (int i=0; i<n; i++)
+      {
+        double const* y_i = _y[i];
+        double        x_k = _x[i][k];
+        for (int a=0; a<num_kept; a++)
+          c[a] += y_i[ kp[a] ]*x_k;
+      }
+
+      #pragma omp parallel for schedule(static)
+      for (int i=0; i<n; i++)
+      {
+        double* x_i = _x[i];
+        double* y_i = _y[i];
+        double  sx  = 0.0;
+        double  sy  = 0.0;
+        for (int a=0; a<num_kept; a++)
+        {
+          sx += c[a]*x_i[ kp[a] ];
+          sy += c[a]*y_i[ kp[a] ];
+        }
+        x_i[k] -= sx;
+        y_i[k] -= sy;
+      }
+    }
+
+    double norm = 0.0;
+    #pragma omp parallel for reduction(+:norm) schedule(static)
+    for (int i=0; i<n; i++)
+      norm += _x[i][k]*_y[i][k];
+
+    if (norm <= _abs_tol2 || norm <= _rel_tol2*norm0)
+      continue;
+
+    double fac = 1.0/sqrt(norm);
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      _x[i][k] *= fac;
+      _y[i][k] *= fac;
+    }
+
+    kept[num_kept++] = k;
+  }
+
+  delete[] c;
+
+  if (num_kept < s)
+  {
+    _x.keep_columns(kp, num_kept);
+    _y.keep_columns(kp, num_kept);
+  }
+
+  return num_kept;
+}
+
+
+
+
+/** Loesung fuer mehrere rechte Seiten mit dem Block-CG-Verfahren
+ *  Die rechten Seiten stehen in den Spalten von f, u enthaelt die
+ *  Startwerte und am Ende die Loesungen.
+ *  Bezeichnungen: r Residuen, z = M*r, p Suchrichtungen, q = A*p
+ *
+ */
+void Solver_BlockCG::solve(
+    Array2D<double>&              _u,                  // Loesungen (i/o)
+    Array2D<double>&              _f                   // rechte Seiten (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("BlockCG: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
+  int n    = _a.get_size();
+  int nrhs = _f.get_size_2();
+
+  int ite = 0;
+
+  Array1D<double> in(n);
+  Array1D<double> out(n);
+  Array1D<int>    act(nrhs);                           // Spalte von u fuer jede aktive Spalte
+  Array1D<int>    keep(nrhs);
+  Array1D<double> gamma(nrhs);
+
+  Array2D<double> r(n, nrhs);
+  Array2D<double> r_tmp;
+  Array2D<double> q;
+  Array2D<double> alpha;
+  Array2D<double> beta;
+
+  // p und z tauschen in jeder Iteration die Rollen, ohne Kopie
+  Array2D<double>  blk_0;
+  Array2D<double>  blk_1;
+  Array2D<double>* p = &blk_0;
+  Array2D<double>* z = &blk_1;
+
+  // Start: r = f - A*u, p = z = M*r
+  _a.mult(_u, r);
+  for (int i=0; i<n; i++)
+    for (int c=0; c<nrhs; c++)
+      r[i][c] = _f[i][c] - r[i][c];
+
+  block_precond(*precond, r, *p, in, out);
+
+  for (int c=0; c<nrhs; c++)
+    act[c] = c;
+
+  int    num_act = nrhs;
+  double res_max = 0.0;                                // groesstes Spalten-Residuum der letzten Iteration
+
+  while (ite < max_ite)
+  {
+    // Suchrichtungen A-orthonormieren, danach gilt p^T*A*p = I
+    set_size(q, n, p->get_size_2());
+    _a.mult(*p, q);
+    orthonormalize(*p, q, 0.0, 1e-20);
+
+    // u = u + p*alpha, r = r - q*alpha  mit alpha = p^T*r
+    block_dot(*p, r, alpha);
+
+    int np = p->get_size_2();
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      double const* p_i = (*p)[i];
+      double const* q_i = q[i];
+      double*       r_i = r[i];
+      double*       u_i = _u[i];
+      for (int c=0; c<num_act; c++)
+      {
+        double sp = 0.0;
+        double sq = 0.0;
+        for (int k=0; k<np; k++)
+        {
+          sp += p_i[k]*alpha[k][c];
+          sq += q_i[k]*alpha[k][c];
+        }
+        u_i[ act[c] ] += sp;
+        r_i[c]        -= sq;
+      }
+    }
+
+    block_precond(*precond, r, *z, in, out);
+    ite++;
+
+
+    // Konvergenz je System pruefen, konvergierte Spalten entfernen
+    double* g = gamma.get_dataptr();
+    for (int c=0; c<num_act; c++)
+      g[c] = 0.0;
+
+    #pragma omp parallel for reduction(+:g[:num_act]) schedule(static)
+    for (int i=0; i<n; i++)
+      for (int c=0; c<num_act; c++)
+        g[c] += r[i][c]*(*z)[i][c];
+
+    double norm_max = 0.0;
+    for (int c=0; c<num_act; c++)
+      norm_max = max(norm_max, sqrt(fabs(g[c])));
+    telemetry_iteration(ite, norm_max);
+    res_max = norm_max;
+
+    int num_keep = 0;
+    for (int c=0; c<num_act; c++)
+      if (sqrt(fabs(g[c])) > tol_ite)
+      {
+        keep[num_keep] = c;
+        act[num_keep]  = act[c];
+        num_keep++;
+      }
+
+    if (num_keep == 0)
+    {
+      num_act = 0;
+      break;
+    }
+
+    if (num_keep < num_act)
+    {
+      r.keep_columns(keep.get_dataptr(), num_keep);
+      z->keep_columns(keep.get_dataptr(), num_keep);
+      num_act = num_keep;
+    }
+
+
+    // Kombinationen der Residuen, die bereits konvergiert sind, liefern
+    // keine neuen Suchrichtungen (Deflation des Residuenblocks)
+    set_size(r_tmp, n, num_act);
+    for (int i=0; i<n; i++)
+      for (int c=0; c<num_act; c++)
+        r_tmp[i][c] = r[i][c];
+
+    orthonormalize(*z, r_tmp, tol_ite*tol_ite, 1e-20);
+
+
+    // neue Suchrichtungen z - p*(q^T*z), A-orthogonal zu den alten
+    block_dot(q, *z, beta);
+    block_update(*z, *p, beta);
+
+    Array2D<double>* tmp = p;
+    p = z;
+    z = tmp;
+  }
+
+  telemetry_finish(num_act > 0 ? CONV_MAX_ITE : CONV_TOLERANCE, ite, res_max);
+  telemetry_end(PHASE_SOLVE);
+
+  if (num_act > 0) {
+    throw runtime_error(string("BlockCG: Not converged in max_ite!!"));
+  } else {
+    cout << "Block CG solver converged successfully in " << ite <<
+      " iterations for " << nrhs << " load cases with tolerance " << tol_ite << "." << endl;
+  }
+
+  return;
+}
@@ -35,20 +35,48 @@ mvs@ibb.uni-stuttgart.de
 #include "Solver.h"
 
 
+/** Vorbereitung des CG-Loesers fuer die Matrix a
+ *  Der Vorkonditionierer wird hier einmalig vorbereitet und fuer alle
+ *  folgenden solve verwendet.
+ *
+ */
+void Solver_CG::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  precond->setup(_a);
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
 /** Loesung des LGS a*u=f mit dem konjugierten Gradienten-Verfahren (CG)
  *
  */
 void Solver_CG::solve(
-    Matrix&                       _a,                  // Matrix des LGS (i)
     Array1D<double>&              _u,                  // Loesungsvektor (o)
     Array1D<double>&              _f                   // rechte Seite Vektor (i)
     )
 {
 
+  if (!factorized)
+    throw runtime_error(string("CG: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
   int n = _a.get_size();
 
   double norm;
-  unsigned int ite = 0;
+  int ite = 0;
 
   // malte's:
   
@@ -106,40 +134,59 @@ void Solver_CG::solve(
 
 
   // preconditioned from 2nd week (Malte):
+  // alle Vektoren werden einmal allokiert, die Iteration arbeitet ohne Temporaere
 
   double norm_r2, norm_r, lambda, beta;
   Array1D<double> r(n);
   Array1D<double> h(n);
   Array1D<double> p(n);
   Array1D<double> ap(n);
-  r = _f - _a * _u;
-  h = precond(_a, r);
-  norm_r2 = r*h;
-  p = h;
+
+  double*       u  = _u.get_dataptr();
+  double const* f  = _f.get_dataptr();
+  double*       rp = r.get_dataptr();
+  double*       hp = h.get_dataptr();
+  double*       pp = p.get_dataptr();
+  double*       app = ap.get_dataptr();
+
+  _a.mult(_u, ap);
+  for (int i=0; i<n; i++)
+    rp[i] = f[i] - app[i];
+  precond->apply(r, h);
+  norm_r2 = dot(r, h);
+  for (int i=0; i<n; i++)
+    pp[i] = hp[i];
 
   do {
-    ap = _a * p;
+    _a.mult(p, ap);
     norm_r = norm_r2;
-    lambda = norm_r / (p * ap);
+    lambda = norm_r / dot(p, ap);
 
     // update
-    _u = _u + lambda * p;
-    r = r - lambda * ap;
-    h = precond(_a, r);
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      u[i]  += lambda * pp[i];
+      rp[i] -= lambda * app[i];
+    }
+    precond->apply(r, h);
 
-    norm_r2 = r * h;
+    norm_r2 = dot(r, h);
 
     beta = norm_r2 / norm_r;
-    p = h + beta * p;
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      pp[i] = hp[i] + beta * pp[i];
 
     ite++;
+    telemetry_iteration(ite, sqrt(norm_r2), lambda, beta);
 
   } while (ite < max_ite && sqrt(norm_r2) > tol_ite);
 
 
-  // print the results
-  //
-  r.print("r:");
+  telemetry_finish(ite == max_ite ? CONV_MAX_ITE : CONV_TOLERANCE, ite, sqrt(norm_r2));
+  telemetry_end(PHASE_SOLVE);
+
   if (ite == max_ite) {
     throw runtime_error(string("CG: Not converged in max_ite!!"));
   } else {
@@ -151,54 +198,195 @@ void Solver_CG::solve(
 }
 
 
-Array1D<double> Solver_CG::precond(Matrix&          _a,  // Matrix des LGS (i)
-                                   Array1D<double>& _r   // unpreconditioned residual (i)
-                                   ) {
-  Array1D<double> h(_a.get_size()); // unpreconditioned residual (o)
-  
-  // No preconditioning; C = Identity
-  //h  = _r;
-  
-  // Jacobi preconditioning; C = D^(-1)
-  for (int i = 0;i < _a.get_size();i++) {
-    h[i] = _r[i] / _a.get_entry(i,i);
+
+
+
+/** Anzahl der Eigenwerte einer symmetrischen Tridiagonalmatrix kleiner x
+ *  (Sturmsche Kette)
+ *
+ */
+static int sturm_count(
+    Array1D<double> const&        _d,                  // Diagonale (i)
+    Array1D<double> const&        _e,                  // Nebendiagonale (i)
+    int                           _m,                  // Groesse (i)
+    double                        _x                   // Schranke (i)
+    )
+{
+  int    count = 0;
+  double q     = 1.0;
+
+  for (int j=0; j<_m; j++)
+  {
+    double e2 = (j > 0) ? _e[j-1]*_e[j-1] : 0.0;
+    q = _d[j] - _x - ((j > 0) ? e2/q : 0.0);
+    if (q == 0.0)
+      q = 1e-300;
+    if (q < 0.0)
+      count++;
   }
 
-  // Gauss-Seidel preconditioning: h = (D-E)^-1 * r
-  // Solve the system (D-E)*h = r to find h
-  // (D-E) is lower triangular so forward subsitution can be used to solve for h
-  // But GS preconditioning cannot be used because CG requires a symmetric
-  // preconditioning matrix C. For this case C = (D-E)^-1 is not symmetric so
-  // GS preconditioning cannot be used with CG method.
-  
-  // Symmetric GS preconditioning:
-  // C = (D-F)^(-1) D (D_E)^-1
-  // => h = (D-F)^(-1) D (D-E)^(-1)  r
-  // (D-E) D^(-1) (D-F) h = r
-  //       \______ _____/
-  //              V
-  //              g
-  //
-  // 1. (D-E) g = r
-  // 2. D^(-1)(D-F) h = g  =>  f = D g
-  //          \_____/
-  //             V
-  //             f
-  //
-  // 3. (D-F) h = f  => backward substitution
-  //
-  // Implementation:
-  //
-  // can be used after vorwaerts and rueckwaerts are implemented
-
-  //h = _a.vorwaerts(_r);
-
-  //for (int i = 0; i < _a.get_size(); i++) {
-    //h[i] = h[i] * _a.get_entry(i,i);
-  //}
-
-  //h = _a.rueckwaerts(h);
-
-  return h;
+  return count;
 }
 
+
+
+
+/** Extreme Eigenwerte der Lanczos-Tridiagonalmatrix zu den ersten m
+ *  CG-Schritten (Saad, Kap. 6.7.3):
+ *    T_jj    = 1/alpha_j + beta_(j-1)/alpha_(j-1)
+ *    T_j,j+1 = sqrt(beta_j)/alpha_j
+ *  Intervall nach Gerschgorin, dann Bisektion mit der Sturmschen Kette.
+ *
+ */
+static void lanczos_bounds(
+    Array1D<double> const&        _alpha,              // CG-Koeffizienten alpha (i)
+    Array1D<double> const&        _beta,               // CG-Koeffizienten beta (i)
+    int                           _m,                  // Anzahl Schritte (i)
+    double&                       _lambda_min,         // kleinster Eigenwert (o)
+    double&                       _lambda_max          // groesster Eigenwert (o)
+    )
+{
+  Array1D<double> d(_m);
+  Array1D<double> e(_m);
+  for (int j=0; j<_m; j++)
+  {
+    d[j] = 1.0/_alpha[j] + ((j > 0) ? _beta[j-1]/_alpha[j-1] : 0.0);
+    e[j] = sqrt(_beta[j])/_alpha[j];
+  }
+
+  double lo = d[0];
+  double hi = d[0];
+  for (int j=0; j<_m; j++)
+  {
+    double rad = ((j > 0) ? fabs(e[j-1]) : 0.0) + ((j < _m-1) ? fabs(e[j]) : 0.0);
+    lo = min(lo, d[j] - rad);
+    hi = max(hi, d[j] + rad);
+  }
+
+  double a = lo, b = hi;
+  for (int k=0; k<100; k++)
+  {
+    double x = 0.5*(a+b);
+    if (sturm_count(d, e, _m, x) >= 1)
+      b = x;
+    else
+      a = x;
+  }
+  _lambda_min = 0.5*(a+b);
+
+  a = lo;
+  b = hi;
+  for (int k=0; k<100; k++)
+  {
+    double x = 0.5*(a+b);
+    if (sturm_count(d, e, _m, x) >= _m)
+      b = x;
+    else
+      a = x;
+  }
+  _lambda_max = 0.5*(a+b);
+
+  return;
+}
+
+
+
+
+/** Schaetzung der Eigenwertschranken von C*A mit einigen CG-Schritten
+ *  Aus den Koeffizienten alpha/beta des vorkonditionierten CG folgt die
+ *  Lanczos-Tridiagonalmatrix T. Die extremen Eigenwerte von T naehern die
+ *  von C*A von innen an, lambda_max konvergiert dabei sehr schnell,
+ *  lambda_min erst nach etwa so vielen Schritten, wie CG zur Loesung
+ *  braucht.
+ *  Mit _tol > 0 wird ueber _steps hinaus weiter iteriert, bis sich
+ *  lambda_min zwischen zwei Pruefungen (bei _steps, 2*_steps, 4*_steps, ...)
+ *  relativ um weniger als _tol aendert.
+ *
+ */
+void Solver_CG::estimate_bounds(
+    Matrix const&                 _a,                  // Matrix (i)
+    Preconditioner const&         _precond,            // Vorkonditionierer C (i)
+    int                           _steps,              // Anzahl CG-Schritte (i)
+    double&                       _lambda_min,         // kleinster Eigenwert (o)
+    double&                       _lambda_max,         // groesster Eigenwert (o)
+    double                        _tol                 // Aenderung von lambda_min fuer Abbruch (i)
+    )
+{
+  int n = _a.get_size();
+
+  if (_steps > n)
+    _steps = n;
+  if (_steps < 1)
+    _steps = 1;
+
+  int max_steps = (_tol > 0.0) ? n : _steps;
+
+  Array1D<double> r(n);
+  Array1D<double> h(n);
+  Array1D<double> p(n);
+  Array1D<double> ap(n);
+  Array1D<double> alpha(max_steps);
+  Array1D<double> beta(max_steps);
+
+  double* rp  = r.get_dataptr();
+  double* hp  = h.get_dataptr();
+  double* pp  = p.get_dataptr();
+  double* app = ap.get_dataptr();
+
+  // rechte Seite mit Pseudo-Zufallszahlen, Startwert Null: r = f
+  unsigned int seed = 12345;
+  for (int i=0; i<n; i++)
+  {
+    seed  = 1103515245u*seed + 12345u;
+    rp[i] = (double)(seed >> 16) / 65536.0 - 0.5;
+  }
+
+  _precond.apply(r, h);
+  double norm_r2 = Solver::dot(r, h);
+  for (int i=0; i<n; i++)
+    pp[i] = hp[i];
+
+  int    m     = 0;
+  int    check = _steps;                               // naechste Pruefung von lambda_min
+  double low   = 0.0;                                  // lambda_min der letzten Pruefung
+
+  while (m < max_steps && norm_r2 > 0.0)
+  {
+    _a.mult(p, ap);
+    double norm_r = norm_r2;
+    alpha[m] = norm_r / Solver::dot(p, ap);
+
+    for (int i=0; i<n; i++)
+      rp[i] -= alpha[m] * app[i];
+    _precond.apply(r, h);
+
+    norm_r2 = Solver::dot(r, h);
+    beta[m] = norm_r2 / norm_r;
+
+    for (int i=0; i<n; i++)
+      pp[i] = hp[i] + beta[m] * pp[i];
+
+    m++;
+
+    if (m == check && m < max_steps)
+    {
+      double high;
+      lanczos_bounds(alpha, beta, m, _lambda_min, high);
+      if (m > _steps && fabs(low - _lambda_min) <= _tol*_lambda_min)
+        break;
+      low   = _lambda_min;
+      check = 2*check;
+    }
+  }
+
+  if (m == 0)
+  {
+    _lambda_min = 1.0;
+    _lambda_max = 1.0;
+    return;
+  }
+
+  lanczos_bounds(alpha, beta, m, _lambda_min, _lambda_max);
+
+  return;
+}
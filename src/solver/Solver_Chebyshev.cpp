@@ -0,0 +1,168 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Vorkonditionierer und Eigenwertschranken von C*A
+ *  Lanczos naehert lambda_max von unten und lambda_min von oben an,
+ *  daher wird das Intervall etwas aufgeweitet.
+ *  lambda_min konvergiert erst nach vielen Schritten, ein zu grosses
+ *  lambda_min verlangsamt die Iteration um Groessenordnungen. Daher wird
+ *  ab lanczos_ite Schritten weiter iteriert, bis sich lambda_min bei
+ *  Verdopplung der Schrittzahl um weniger als 10% aendert.
+ *
+ */
+void Solver_Chebyshev::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  Solver_CG::factorize(_a);
+
+  estimate_bounds(_a, *precond, lanczos_ite, lambda_min, lambda_max, 0.1);
+  lambda_max *= 1.05;
+  lambda_min *= 0.95;
+
+  telemetry_end(PHASE_FACTORIZE);
+
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit der vorkonditionierten Chebyshev-Iteration
+ *  Bezeichnungen: r Residuum, h = C*r, d Korrektur
+ *
+ */
+void Solver_Chebyshev::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("Chebyshev: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
+  int n = _a.get_size();
+
+  int ite = 0;
+
+  Array1D<double> r(n);
+  Array1D<double> h(n);
+  Array1D<double> d(n);
+  Array1D<double> ad(n);
+
+  double*       u   = _u.get_dataptr();
+  double const* f   = _f.get_dataptr();
+  double*       rp  = r.get_dataptr();
+  double*       hp  = h.get_dataptr();
+  double*       dp  = d.get_dataptr();
+  double*       adp = ad.get_dataptr();
+
+  double theta = 0.5 * (lambda_max + lambda_min);
+  double delta = 0.5 * (lambda_max - lambda_min);
+  double sigma = theta / delta;
+  double rho   = 1.0 / sigma;
+  double norm  = 0.0;
+  bool   converged = false;
+
+  _a.mult(_u, ad);
+  for (int i=0; i<n; i++)
+    rp[i] = f[i] - adp[i];
+  precond->apply(r, h);
+
+  for (int i=0; i<n; i++)
+    dp[i] = hp[i] / theta;
+
+  while (ite < max_ite)
+  {
+    _a.mult(d, ad);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      u[i]  += dp[i];
+      rp[i] -= adp[i];
+    }
+    precond->apply(r, h);
+    ite++;
+
+    // Konvergenzpruefung, die einzige Reduktion der Iteration
+    if (ite % check_ite == 0)
+    {
+      norm = 0.0;
+      #pragma omp parallel for reduction(+:norm) schedule(static)
+      for (int i=0; i<n; i++)
+        norm += rp[i]*hp[i];
+
+      telemetry_iteration(ite, sqrt(fabs(norm)));
+
+      if (sqrt(fabs(norm)) <= tol_ite)
+      {
+        converged = true;
+        break;
+      }
+    }
+
+    double rho_new = 1.0 / (2.0*sigma - rho);
+    double c1      = rho_new * rho;
+    double c2      = 2.0 * rho_new / delta;
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      dp[i] = c1 * dp[i] + c2 * hp[i];
+
+    rho = rho_new;
+  }
+
+  telemetry_finish(converged ? CONV_TOLERANCE : CONV_MAX_ITE, ite, sqrt(fabs(norm)));
+  telemetry_end(PHASE_SOLVE);
+
+  if (!converged) {
+    throw runtime_error(string("Chebyshev: Not converged in max_ite!!"));
+  } else {
+    cout << "Chebyshev solver converged successfully in " << ite <<
+      " iterations with tolerance " << tol_ite << " (lambda in [" <<
+      lambda_min << ", " << lambda_max << "])." << endl;
+  }
+
+  return;
+}
@@ -0,0 +1,341 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+ */
+
+#include "Main.h"
+#include "Solver.h"
+#include <algorithm>
+
+/** Cholesky-Faktorisierung der Matrix a
+ *  Es wird nur das untere Dreieck der Matrix gelesen. Ist die Matrix nicht
+ *  positiv definit, wird ein Fehler geworfen (negativer oder verschwindender
+ *  Radikand bei der Berechnung eines Diagonalelements).
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+)
+{
+
+  telemetry_begin(PHASE_FACTORIZE);
+
+  num_eq = _a.get_size();
+  int n  = num_eq;
+
+  l.resize( (int)((long)n*(n+1)/2) );
+
+  for (int i=0; i<n; i++)
+  {
+    T* l_i = row(i);
+    for (int j=0; j<=i; j++)
+      l_i[j] = _a.get_entry(i,j);
+  }
+
+
+  // geblockte Faktorisierung
+  for (int k0=0; k0<n; k0+=block_size)
+  {
+    int k1 = min(k0+block_size, n);
+
+    factor_diagonal(k0, k1);
+    factor_panel(k0, k1);
+    update_trailing(k0, k1);
+  }
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit der gespeicherten Cholesky-Faktorisierung
+ *  L*y = f (vorwaerts), L^T*u = y (rueckwaerts, spaltenweise)
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+)
+{
+
+  if (!factorized)
+    throw runtime_error(string("Cholesky: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n = num_eq;
+  double* u = _u.get_dataptr();
+
+
+  // forward
+  for (int i=0; i<n; i++)
+  {
+    T const* l_i = row(i);
+    double sum = _f[i];
+    for (int j=0; j<i; j++)
+      sum -= l_i[j] * u[j];
+    u[i] = sum / l_i[i];
+  }
+
+
+  // backward, L^T wird spaltenweise (d.h. ueber die Zeilen von L) abgearbeitet
+  for (int i=n-1; i>=0; i--)
+  {
+    T const* l_i = row(i);
+    u[i] /= l_i[i];
+    double u_i = u[i];
+    for (int j=0; j<i; j++)
+      u[j] -= l_i[j] * u_i;
+  }
+
+  telemetry_finish(CONV_DIRECT, 0, 0.0);
+  telemetry_end(PHASE_SOLVE);
+
+  return;
+}
+
+
+
+
+/** Loesung fuer mehrere rechte Seiten mit der gespeicherten Cholesky-Faktorisierung
+ *  Die rechten Seiten stehen in den Spalten von f.
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::solve(
+    Array2D<double>&              _u,                  // Loesungen (o)
+    Array2D<double>&              _f                   // rechte Seiten (i)
+)
+{
+
+  if (!factorized)
+    throw runtime_error(string("Cholesky: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n    = num_eq;
+  int nrhs = _f.get_size_2();
+
+
+  // forward
+  for (int i=0; i<n; i++)
+  {
+    T const* l_i = row(i);
+    double*       u_i = _u[i];
+    double const* f_i = _f[i];
+
+    for (int c=0; c<nrhs; c++)
+      u_i[c] = f_i[c];
+
+    for (int j=0; j<i; j++)
+    {
+      double        lij = l_i[j];
+      double const* u_j = _u[j];
+      for (int c=0; c<nrhs; c++)
+        u_i[c] -= lij * u_j[c];
+    }
+
+    double d = 1.0/l_i[i];
+    for (int c=0; c<nrhs; c++)
+      u_i[c] *= d;
+  }
+
+
+  // backward
+  for (int i=n-1; i>=0; i--)
+  {
+    T const* l_i = row(i);
+    double*       u_i = _u[i];
+
+    double d = 1.0/l_i[i];
+    for (int c=0; c<nrhs; c++)
+      u_i[c] *= d;
+
+    for (int j=0; j<i; j++)
+    {
+      double  lij = l_i[j];
+      double* u_j = _u[j];
+      for (int c=0; c<nrhs; c++)
+        u_j[c] -= lij * u_i[c];
+    }
+  }
+
+  telemetry_finish(CONV_DIRECT, 0, 0.0);
+  telemetry_end(PHASE_SOLVE);
+
+  return;
+}
+
+
+
+
+/** Unblockierte Faktorisierung des Diagonalblocks (Zeilen/Spalten k0 bis k1-1)
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::factor_diagonal(
+    int                           _k0,                 // erste Spalte des Blocks (i)
+    int                           _k1                  // erste Spalte nach dem Block (i)
+)
+{
+  for (int i=_k0; i<_k1; i++)
+  {
+    T* l_i = row(i);
+
+    for (int j=_k0; j<=i; j++)
+    {
+      T const* l_j = row(j);
+      double sum = l_i[j];
+      for (int p=_k0; p<j; p++)
+        sum -= l_i[p] * l_j[p];
+
+      if (j < i)
+      {
+        l_i[j] = sum / l_j[j];
+      }
+      else
+      {
+        // Verlust der positiven Definitheit
+        if (sum <= 0.0)
+        {
+          stringstream msg;
+          msg << "Cholesky: matrix not positive definite in row " << i << "!!";
+          throw runtime_error(msg.str());
+        }
+        l_i[i] = sqrt(sum);
+      }
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** Panel unterhalb des Diagonalblocks: L21 = A21 * L11^-T
+ *  Jede Zeile ist unabhaengig und wird parallel berechnet.
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::factor_panel(
+    int                           _k0,                 // erste Spalte des Blocks (i)
+    int                           _k1                  // erste Spalte nach dem Block (i)
+)
+{
+  int n = num_eq;
+
+  #pragma omp parallel for schedule(static)
+  for (int i=_k1; i<n; i++)
+  {
+    T* l_i = row(i);
+
+    for (int j=_k0; j<_k1; j++)
+    {
+      T const* l_j = row(j);
+      double sum = l_i[j];
+      for (int p=_k0; p<j; p++)
+        sum -= l_i[p] * l_j[p];
+      l_i[j] = sum / l_j[j];
+    }
+  }
+
+  return;
+}
+
+
+
+
+/** symmetrische Aktualisierung der Restmatrix: A22 = A22 - L21 * L21^T
+ *  Nur das untere Dreieck wird berechnet. Vier Spalten werden gleichzeitig
+ *  bearbeitet, damit der Panel-Abschnitt der Zeile i im Register/L1 bleibt.
+ *
+ */
+template <class T>
+void Solver_Cholesky_T<T>::update_trailing(
+    int                           _k0,                 // erste Spalte des Blocks (i)
+    int                           _k1                  // erste Spalte nach dem Block (i)
+)
+{
+  int n = num_eq;
+
+  // die Zeilen werden nach unten laenger, daher dynamische Verteilung
+  #pragma omp parallel for schedule(dynamic, 16)
+  for (int i=_k1; i<n; i++)
+  {
+    T*       l_i = row(i);
+    T const* p_i = l_i + _k0;
+    int           nb  = _k1 - _k0;
+    int           j   = _k1;
+
+    for (; j+3<=i; j+=4)
+    {
+      T const* p0 = row(j  ) + _k0;
+      T const* p1 = row(j+1) + _k0;
+      T const* p2 = row(j+2) + _k0;
+      T const* p3 = row(j+3) + _k0;
+      T s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+      for (int p=0; p<nb; p++)
+      {
+        s0 += p_i[p] * p0[p];
+        s1 += p_i[p] * p1[p];
+        s2 += p_i[p] * p2[p];
+        s3 += p_i[p] * p3[p];
+      }
+      l_i[j  ] -= s0;
+      l_i[j+1] -= s1;
+      l_i[j+2] -= s2;
+      l_i[j+3] -= s3;
+    }
+
+    for (; j<=i; j++)
+    {
+      T const* p_j = row(j) + _k0;
+      T s = 0;
+      for (int p=0; p<nb; p++)
+        s += p_i[p] * p_j[p];
+      l_i[j] -= s;
+    }
+  }
+
+  return;
+}
+
+
+
+
+// Instanzen fuer doppelte und einfache Genauigkeit des Faktors
+template class Solver_Cholesky_T<double>;
+template class Solver_Cholesky_T<float>;
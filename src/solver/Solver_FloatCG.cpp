@@ -0,0 +1,194 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Werte der MSR-Matrix als float kopieren
+ *
+ */
+void Solver_FloatCG::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  msr = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (msr == NULL)
+    throw runtime_error(string("FloatCG: only implemented for Matrix_MSR!!"));
+
+  int n   = msr->get_size();
+  int len = msr->get_nnz()+1;
+
+  double const* val = msr->get_value();
+
+  value.resize(len);
+  diag_inv.resize(n);
+
+  float* v  = value.get_dataptr();
+  float* di = diag_inv.get_dataptr();
+
+  for (int k=0; k<len; k++)
+    v[k] = (float)val[k];
+  for (int i=0; i<n; i++)
+    di[i] = (float)(1.0 / val[i]);
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Matrix-Vektor-Produkt y = A*x in float
+ *
+ */
+void Solver_FloatCG::mult(
+    float const*                  _x,                  // Vektor (i)
+    float*                        _y                   // Ergebnis (o)
+    ) const
+{
+  int           n   = msr->get_size();
+  int   const*  idx = msr->get_index();
+  float const*  v   = value.get_dataptr();
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    float sum = v[i] * _x[i];
+    for (int j=idx[i]; j<idx[i+1]; j++)
+      sum += v[j] * _x[ idx[j] ];
+    _y[i] = sum;
+  }
+
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit Jacobi-vorkonditioniertem CG in float
+ *  u wird als Startwert verwendet.
+ *
+ */
+void Solver_FloatCG::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("FloatCG: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n = msr->get_size();
+
+  Array1D<float> u(n);
+  Array1D<float> r(n);
+  Array1D<float> h(n);
+  Array1D<float> p(n);
+  Array1D<float> ap(n);
+
+  float*        up  = u.get_dataptr();
+  float*        rp  = r.get_dataptr();
+  float*        hp  = h.get_dataptr();
+  float*        pp  = p.get_dataptr();
+  float*        app = ap.get_dataptr();
+  float const*  di  = diag_inv.get_dataptr();
+  double*       ud  = _u.get_dataptr();
+  double const* f   = _f.get_dataptr();
+
+  for (int i=0; i<n; i++)
+    up[i] = (float)ud[i];
+
+  mult(up, app);
+
+  double norm_r2 = 0.0;
+  #pragma omp parallel for reduction(+:norm_r2) schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    rp[i]    = (float)(f[i] - app[i]);
+    hp[i]    = di[i] * rp[i];
+    pp[i]    = hp[i];
+    norm_r2 += (double)rp[i]*hp[i];
+  }
+
+  double norm_0 = norm_r2;
+  int ite = 0;
+
+  while (ite < max_ite && norm_r2 > rel_tol*rel_tol*norm_0)
+  {
+    mult(pp, app);
+
+    double pap = 0.0;
+    #pragma omp parallel for reduction(+:pap) schedule(static)
+    for (int i=0; i<n; i++)
+      pap += (double)pp[i]*app[i];
+
+    float  lambda = (float)(norm_r2 / pap);
+    double norm_r = norm_r2;
+
+    norm_r2 = 0.0;
+    #pragma omp parallel for reduction(+:norm_r2) schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      up[i]    += lambda * pp[i];
+      rp[i]    -= lambda * app[i];
+      hp[i]     = di[i] * rp[i];
+      norm_r2  += (double)rp[i]*hp[i];
+    }
+
+    float beta = (float)(norm_r2 / norm_r);
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      pp[i] = hp[i] + beta * pp[i];
+
+    ite++;
+    telemetry_iteration(ite, sqrt(norm_r2), lambda, beta);
+  }
+
+  for (int i=0; i<n; i++)
+    ud[i] = up[i];
+
+  telemetry_finish(norm_r2 > rel_tol*rel_tol*norm_0 ? CONV_MAX_ITE : CONV_TOLERANCE, ite, sqrt(norm_r2));
+  telemetry_end(PHASE_SOLVE);
+
+  cout << "Float CG solver: " << ite << " iterations, relative residual " <<
+    ((norm_0 > 0.0) ? sqrt(norm_r2/norm_0) : 0.0) << "." << endl;
+
+  return;
+}
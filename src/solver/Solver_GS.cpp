@@ -33,59 +33,307 @@ mvs@ibb.uni-stuttgart.de
 #include "Solver.h"
 #include <stdexcept>
 
-/** Loesung des LGS a*u=f mit dem konjugierten Gradienten-Verfahren (CG)
+
+/** Vorbereitung: MSR-Matrix bereitstellen, Diagonale invertieren, omega bestimmen
+ *
+ */
+void Solver_GS::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  delete msr_own;
+  msr_own = NULL;
+
+  msr = dynamic_cast<Matrix_MSR const*>(&_a);
+
+  if (msr == NULL)
+  {
+    // einmalige Kopie der Nicht-Null-Eintraege in das MSR-Format,
+    // erst zaehlen, dann fuellen
+    int n = _a.get_size();
+    Array1D<int> ptr(n+1);
+
+    ptr[0] = 0;
+    for (int i=0; i<n; i++)
+    {
+      ptr[i+1] = ptr[i];
+      for (int j=0; j<n; j++)
+        if (i == j || _a.get_entry(i,j) != 0.0)
+          ptr[i+1]++;
+    }
+
+    Array1D<int>    col_a( max(ptr[n],1) );
+    Array1D<double> val_a( max(ptr[n],1) );
+    int k = 0;
+    for (int i=0; i<n; i++)
+      for (int j=0; j<n; j++)
+      {
+        double a_ij = _a.get_entry(i,j);
+        if (i == j || a_ij != 0.0)
+        {
+          col_a[k] = j;
+          val_a[k] = a_ij;
+          k++;
+        }
+      }
+
+    msr_own = new Matrix_MSR(n, ptr.get_dataptr(), col_a.get_dataptr(), val_a.get_dataptr());
+    msr     = msr_own;
+  }
+
+  int n = msr->get_size();
+  diag_inv.resize(n);
+  res.resize(n);
+
+  for (int i=0; i<n; i++)
+    diag_inv[i] = 1.0 / msr->get_value()[i];
+
+  Solver::factorize(_a);
+
+  if (omega > 0.0)
+    omega_used = omega;
+  else
+    omega_used = estimate_omega();
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Ein SOR-Durchlauf direkt auf u, nur ueber die gespeicherten Eintraege
+ *
+ */
+void Solver_GS::sweep(
+    Array1D<double> const&        _f,                  // rechte Seite (i)
+    Array1D<double>&              _u,                  // Naeherung (i/o)
+    double                        _omega,              // Relaxationsfaktor (i)
+    bool                          _backward            // Rueckwaertsdurchlauf (i)
+    )
+{
+  double const* val = msr->get_value();
+  int    const* idx = msr->get_index();
+  double const* f   = _f.get_dataptr();
+  double*       u   = _u.get_dataptr();
+  double const* di  = diag_inv.get_dataptr();
+
+  int n = msr->get_size();
+
+  for (int k=0; k<n; k++)
+  {
+    int    i   = _backward ? n-1-k : k;
+    double sum = f[i];
+    for (int j=idx[i]; j<idx[i+1]; j++)
+      sum -= val[j] * u[ idx[j] ];
+
+    u[i] += _omega * (sum*di[i] - u[i]);
+  }
+
+  return;
+}
+
+
+
+
+/** Konvergenzfaktor des Verfahrens fuer einen gegebenen Relaxationsfaktor
+ *  Einige Schritte fuer a*u=0 mit zufaelligem Startvektor (Potenzmethode),
+ *  Rueckgabe ist das Verhaeltnis der Normen im letzten Schritt.
+ *
+ */
+double Solver_GS::convergence_factor(
+    double                        _omega,              // Relaxationsfaktor (i)
+    int                           _ite                 // Anzahl Schritte (i)
+    )
+{
+  int n = msr->get_size();
+
+  Array1D<double> zero(n);
+  Array1D<double> u(n);
+  zero.init();
+
+  double* up = u.get_dataptr();
+
+  unsigned int seed = 12345;
+  for (int i=0; i<n; i++)
+  {
+    seed  = 1103515245u*seed + 12345u;
+    up[i] = (double)(seed >> 16) / 65536.0 - 0.5;
+  }
+
+  double rho    = 0.0;
+  double norm_0 = 0.0;
+  for (int i=0; i<n; i++)
+    norm_0 += up[i]*up[i];
+  norm_0 = sqrt(norm_0);
+
+  for (int k=0; k<_ite; k++)
+  {
+    sweep(zero, u, _omega, false);
+    if (symmetric)
+      sweep(zero, u, _omega, true);
+
+    double norm_1 = 0.0;
+    for (int i=0; i<n; i++)
+      norm_1 += up[i]*up[i];
+    norm_1 = sqrt(norm_1);
+
+    if (norm_1 == 0.0)
+      break;
+
+    rho = norm_1 / norm_0;
+
+    for (int i=0; i<n; i++)
+      up[i] /= norm_1;
+    norm_0 = 1.0;
+  }
+
+  return rho;
+}
+
+
+
+
+/** Schaetzung des optimalen Relaxationsfaktors
+ *  SOR: aus dem Konvergenzfaktor von Gauss-Seidel rho_GS = rho_J^2 folgt
+ *  omega = 2 / (1 + sqrt(1 - rho_GS)) (Young).
+ *  SSOR: fuer SSOR gibt es keine entsprechende Formel, und der Konvergenzfaktor
+ *  haengt nicht unimodal von omega ab. Daher wird er auf dem Raster
+ *  1.0, 1.1, ..., 1.9, 1.98 bestimmt und um das beste Rasterelement durch
+ *  Goldenen Schnitt in [1.0, 1.98] verfeinert.
+ *
+ */
+double Solver_GS::estimate_omega()
+{
+  if (symmetric)
+  {
+    int    steps      = 200;
+    double w_max      = 1.98;
+    double best_omega = 1.0;
+    double best_rho   = convergence_factor(1.0, steps);
+
+    for (int k=1; k<=10; k++)
+    {
+      double w   = (k < 10) ? 1.0 + 0.1*k : w_max;
+      double rho = convergence_factor(w, steps);
+      if (rho < best_rho)
+      {
+        best_rho   = rho;
+        best_omega = w;
+      }
+    }
+
+    // Goldener Schnitt im Intervall um das beste Rasterelement
+    double gr = 0.5*(sqrt(5.0) - 1.0);
+    double a  = max(best_omega - 0.1, 1.0);
+    double b  = min(best_omega + 0.1, w_max);
+    double c  = b - gr*(b - a);
+    double d  = a + gr*(b - a);
+    double fc = convergence_factor(c, steps);
+    double fd = convergence_factor(d, steps);
+
+    for (int k=0; k<8; k++)
+    {
+      if (fc < best_rho) { best_rho = fc; best_omega = c; }
+      if (fd < best_rho) { best_rho = fd; best_omega = d; }
+
+      if (fc < fd)
+      {
+        b  = d;
+        d  = c;
+        fd = fc;
+        c  = b - gr*(b - a);
+        fc = convergence_factor(c, steps);
+      }
+      else
+      {
+        a  = c;
+        c  = d;
+        fc = fd;
+        d  = a + gr*(b - a);
+        fd = convergence_factor(d, steps);
+      }
+    }
+
+    if (fc < best_rho) { best_rho = fc; best_omega = c; }
+    if (fd < best_rho) { best_rho = fd; best_omega = d; }
+
+    return best_omega;
+  }
+
+  double rho = convergence_factor(1.0, 30);
+
+  if (rho >= 1.0)
+    rho = 1.0 - 1e-12;
+
+  return 2.0 / (1.0 + sqrt(1.0 - rho));
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit dem Gauss-Seidel/SOR/SSOR-Verfahren
+ *  u wird als Startwert verwendet.
  *
  */
 void Solver_GS::solve(
-    Matrix&                       _a,                  // Matrix des LGS (i)
-    Array1D<double>&              _u,                  // Loesungsvektor (o)
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
     Array1D<double>&              _f                   // rechte Seite Vektor (i)
     )
 {
 
-  int n = _a.get_size();
-  Array1D<double> y(n);
-  
-  double norm;
-  double sum;
+  if (!factorized)
+    throw runtime_error(string("GS: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n = msr->get_size();
+
+  double const* f = _f.get_dataptr();
+  double*       r = res.get_dataptr();
+
+  double norm = 0.0;
   int ite = 0;
+  bool converged = false;
 
-  do {
-    norm = 0;
-    // x^(k+1) == u
-    // x^(k)   == y
-    
-    // copy new solution to old solution
-
-    for (int j = 0; j < n; j++) 
-      y[j] = _u[j];
-
-    for (int i = 0; i < n; i++) {
-      // _u[i]
-      sum = _f[i];
-      // loop all rows above i
-      for (int j = 0; j < i; j++) 
-        sum -= _a.get_entry(i,j) * _u[j];
-      // loop all rows below i
-      for (int j = i+1; j < n; j++) 
-        sum -= _a.get_entry(i,j) * y[j];
-
-      _u[i] = sum / _a.get_entry(i,i);
-
-      norm += (y[i] - _u[i]) * (y[i] - _u[i]);
-    }
+  while (ite < max_ite)
+  {
+    sweep(_f, _u, omega_used, false);
+    if (symmetric)
+      sweep(_f, _u, omega_used, true);
     ite++;
-    //cout << norm << endl;
-  } while (sqrt(norm) > tol_ite && ite < max_ite);
 
-  if (ite == max_ite) {
+    // wahres Residuum r = f - a*u nur alle res_stride Schritte
+    if (ite % res_stride == 0 || ite == max_ite)
+    {
+      msr->mult(_u, res);
+
+      norm = 0.0;
+      #pragma omp parallel for reduction(+:norm) schedule(static)
+      for (int i=0; i<n; i++)
+        norm += (f[i]-r[i]) * (f[i]-r[i]);
+
+      telemetry_iteration(ite, sqrt(norm), omega_used);
+
+      if (sqrt(norm) <= tol_ite)
+      {
+        converged = true;
+        break;
+      }
+    }
+  }
+
+  telemetry_finish(converged ? CONV_TOLERANCE : CONV_MAX_ITE, ite, sqrt(norm));
+  telemetry_end(PHASE_SOLVE);
+
+  if (!converged) {
     throw runtime_error(string("GS: Not converged in max_ite!!"));
   } else {
-    cout << "G-S solver converged successfully in " << ite << 
-      " iterations with tolerance " << tol_ite << "." << endl; 
+    cout << "G-S solver converged successfully in " << ite <<
+      " iterations with tolerance " << tol_ite << " (omega " << omega_used << ")." << endl;
   }
 
   return;
 }
-
-
@@ -31,18 +31,18 @@ mvs@ibb.uni-stuttgart.de
 
 #include "Main.h"
 #include "Solver.h"
+#include <algorithm>
 
-/** Loesung des LGS a*u=f mit LU-Faktorisierung (LU)
+/** LU-Faktorisierung der Matrix a
+ *  Die Faktoren und die Zeilenvertauschungen werden im Loeser gespeichert.
  *
  */
-void Solver_LU::solve(
-    Matrix&                       _a,                  // Matrix des LGS (i)
-    Array1D<double>&              _u,                  // Loesungsvektor (o)
-    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+void Solver_LU::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
 )
 {
 
-  double sum;
+  telemetry_begin(PHASE_FACTORIZE);
 
   int n= _a.get_size();
   lu.resize(n,n);
@@ -55,15 +55,162 @@ void Solver_LU::solve(
   for (int i=0;i<n;i++)
     swap[i] = i;
 
-  lu.print("A");
+
+  // geblockte Faktorisierung: Panel faktorisieren, Restmatrix aktualisieren
+  for (int k0=0; k0<n; k0+=block_size)
+  {
+    int nb = min(block_size, n-k0);
+
+    factor_panel(k0, nb);
+    update_trailing(k0, nb);
+  }
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit der gespeicherten LU-Faktorisierung
+ *
+ */
+void Solver_LU::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+)
+{
+
+  double sum;
+
+  if (!factorized)
+    throw runtime_error(string("LU: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n = lu.get_size_1();
+
+
+  // forward
+  for (int i=0; i<n; i++)
+  {
+    double const* lu_i = lu[i];
+    sum = _f[ swap[i] ];
+    for (int j=0; j<i; j++)
+      sum -= lu_i[j] * _u[j];
+    _u[i] = sum;
+  }
+
+
+  // backward
+  for (int i=n-1; i>=0; i--)
+  {
+    double const* lu_i = lu[i];
+    sum = _u[i];
+    for (int j=i+1; j<n; j++)
+      sum -= lu_i[j] * _u[j];
+    _u[i] = sum/lu_i[i];
+  }
+
+  telemetry_finish(CONV_DIRECT, 0, 0.0);
+  telemetry_end(PHASE_SOLVE);
+
+  return;
+}
+
+
 
 
-  for (int i=0; i<n; i++) // looping all pivot elements
+/** Loesung fuer mehrere rechte Seiten mit der gespeicherten LU-Faktorisierung
+ *  Die rechten Seiten stehen in den Spalten von f, eine Zeile von u bzw. f
+ *  enthaelt also den Wert eines Freiheitsgrads fuer alle Lastfaelle.
+ *
+ */
+void Solver_LU::solve(
+    Array2D<double>&              _u,                  // Loesungen (o)
+    Array2D<double>&              _f                   // rechte Seiten (i)
+)
+{
+
+  if (!factorized)
+    throw runtime_error(string("LU: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n    = lu.get_size_1();
+  int nrhs = _f.get_size_2();
+
+
+  // forward
+  for (int i=0; i<n; i++)
   {
+    double const* lu_i = lu[i];
+    double*       u_i  = _u[i];
+    double const* f_i  = _f[ swap[i] ];
+
+    for (int c=0; c<nrhs; c++)
+      u_i[c] = f_i[c];
 
-    // Pivoting (swapping rows)
-    double big  = 0.0;
-    int    imax = -1;
+    for (int j=0; j<i; j++)
+    {
+      double        l   = lu_i[j];
+      double const* u_j = _u[j];
+      for (int c=0; c<nrhs; c++)
+        u_i[c] -= l * u_j[c];
+    }
+  }
+
+
+  // backward
+  for (int i=n-1; i>=0; i--)
+  {
+    double const* lu_i = lu[i];
+    double*       u_i  = _u[i];
+
+    for (int j=i+1; j<n; j++)
+    {
+      double        l   = lu_i[j];
+      double const* u_j = _u[j];
+      for (int c=0; c<nrhs; c++)
+        u_i[c] -= l * u_j[c];
+    }
+
+    double d = 1.0/lu_i[i];
+    for (int c=0; c<nrhs; c++)
+      u_i[c] *= d;
+  }
+
+  telemetry_finish(CONV_DIRECT, 0, 0.0);
+  telemetry_end(PHASE_SOLVE);
+
+  return;
+}
+
+
+
+
+/** Faktorisierung eines Panels (Spalten k0 bis k0+nb-1)
+ *  Unblockierte LU-Zerlegung mit Spaltenpivotisierung, die nur auf den
+ *  Spalten des Panels arbeitet. Zeilenvertauschungen werden fuer die
+ *  gesamte Zeile durchgefuehrt.
+ *
+ */
+void Solver_LU::factor_panel(
+    int                           _k0,                 // erste Spalte des Panels (i)
+    int                           _nb                  // Anzahl Spalten des Panels (i)
+)
+{
+  int n    = lu.get_size_1();
+  int kend = _k0 + _nb;
+
+  for (int i=_k0; i<kend; i++) // looping all pivot elements of the panel
+  {
+
+    // Pivoting: groesstes Element in Spalte i, einschliesslich der Diagonalen
+    double big  = fabs(lu[i][i]);
+    int    imax = i;
     for (int ll=i+1; ll<n; ll++) // loop rows below pivot
     {
       if ( fabs(lu[ll][i]) > big )
@@ -74,65 +221,117 @@ void Solver_LU::solve(
     }
 
     // swap rows i and imax
-    if ( imax != -1 && i != imax )
+    if ( i != imax )
     {
-      cout << "Swapping " << i << " and " << imax << endl;
-      for (int k=0;k<n;k++)
-      {
-        double temp = lu[imax][k];
-        lu[imax][k] = lu[i][k];
-        lu[i][k]    = temp;
-      }
+      std::swap_ranges(lu[i], lu[i]+n, lu[imax]);
 
       int tempi    = swap[imax];
       swap[imax]  = swap[i];
       swap[i]     = tempi;
-
     }
 
 
     // check the pivot element
-    if ( fabs(lu[i][i]) < 1e-12 )
+    if ( big < 1e-12 )
     {
       cout << "LU: singular matrix!" << endl;
       exit(1);
     }
 
+    double const  piv   = lu[i][i];
+    double const* lu_i  = lu[i];
+
+    #pragma omp parallel for schedule(static) if (n-i > 256)
     for (int ll=i+1; ll<n; ll++) // loop rows below pivot
     {
-      lu[ll][i] /= lu[i][i];
-      for (int k=i+1; k<n; k++)
-        lu[ll][k] -= lu[ll][i]*lu[i][k];
+      double* lu_l = lu[ll];
+      double  l    = lu_l[i] / piv;
+      lu_l[i] = l;
+      for (int k=i+1; k<kend; k++)
+        lu_l[k] -= l*lu_i[k];
     }
   }
-  lu.print("LU:");
-  swap.print_int("Swap:");
-  //_f.print("F:");
 
+  return;
+}
 
-  // forward
-  for (int i=0; i<n; i++)
+
+
+
+/** Aktualisierung der Restmatrix nach der Faktorisierung eines Panels
+ *  1. U12 = L11^-1 * A12  (Dreieckssystem im Block der Panel-Zeilen)
+ *  2. A22 = A22 - L21 * U12  (Matrix-Matrix-Produkt, parallel ueber die Zeilen)
+ *  Die Spalten der Restmatrix werden in Kacheln bearbeitet, damit der
+ *  zugehoerige Teil von U12 im Cache bleibt.
+ *
+ */
+void Solver_LU::update_trailing(
+    int                           _k0,                 // erste Spalte des Panels (i)
+    int                           _nb                  // Anzahl Spalten des Panels (i)
+)
+{
+  int n    = lu.get_size_1();
+  int kend = _k0 + _nb;
+
+  if (kend >= n)
+    return;
+
+  const int tile = 256;                                // Spalten pro Kachel
+
+
+  // 1. U12 = L11^-1 * A12 (L11 hat Einsen auf der Diagonalen)
+  #pragma omp parallel for schedule(static) if (n-kend > 2*tile)
+  for (int c0=kend; c0<n; c0+=tile)
   {
-    sum = _f[ swap[i] ];
-    //sum = _f[i];
-    for (int j=0; j<i; j++)
-      sum -= lu[i][j] * _u[j];
-    _u[i] = sum;
+    int c1 = min(c0+tile, n);
+    for (int i=_k0; i<kend; i++)
+    {
+      double const* lu_i = lu[i];
+      for (int ll=i+1; ll<kend; ll++)
+      {
+        double* lu_l = lu[ll];
+        double  l    = lu_l[i];
+        for (int k=c0; k<c1; k++)
+          lu_l[k] -= l*lu_i[k];
+      }
+    }
   }
 
 
-  // backward
-  for (int i=n-1; i>=0; i--)
+  // 2. A22 = A22 - L21 * U12
+  #pragma omp parallel for schedule(static)
+  for (int ll=kend; ll<n; ll++)
   {
-    sum = _u[i];
-    for (int j=i+1; j<n; j++)
-      sum -= lu[i][j] * _u[j];
-    _u[i] = sum/lu[i][i];
-  }
+    double* lu_l = lu[ll];
+    for (int c0=kend; c0<n; c0+=tile)
+    {
+      int c1 = min(c0+tile, n);
+      int i  = _k0;
+
+      // vier Zeilen von U12 gleichzeitig, spart Lade-/Speicherzugriffe auf A22
+      for (; i+3<kend; i+=4)
+      {
+        double const* u0 = lu[i];
+        double const* u1 = lu[i+1];
+        double const* u2 = lu[i+2];
+        double const* u3 = lu[i+3];
+        double l0 = lu_l[i];
+        double l1 = lu_l[i+1];
+        double l2 = lu_l[i+2];
+        double l3 = lu_l[i+3];
+        for (int k=c0; k<c1; k++)
+          lu_l[k] -= l0*u0[k] + l1*u1[k] + l2*u2[k] + l3*u3[k];
+      }
 
-  //_u.print("u:");
+      for (; i<kend; i++)
+      {
+        double const* lu_i = lu[i];
+        double        l    = lu_l[i];
+        for (int k=c0; k<c1; k++)
+          lu_l[k] -= l*lu_i[k];
+      }
+    }
+  }
 
   return;
 }
-
-
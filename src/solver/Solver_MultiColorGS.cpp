@@ -0,0 +1,122 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung: Faerbung der Matrix
+ *
+ */
+void Solver_MultiColorGS::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  msr = dynamic_cast<Matrix_MSR const*>(&_a);
+  if (msr == NULL)
+    throw runtime_error(string("MultiColorGS: only implemented for Matrix_MSR!!"));
+
+  gs.setup(*msr);
+  res.resize(msr->get_size());
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit dem Mehrfarben-Gauss-Seidel/SOR-Verfahren
+ *
+ */
+void Solver_MultiColorGS::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("MultiColorGS: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  int n = msr->get_size();
+
+  double const* f = _f.get_dataptr();
+  double*       r = res.get_dataptr();
+
+  double norm = 0.0;
+  int ite = 0;
+  bool converged = false;
+
+  while (ite < max_ite)
+  {
+    gs.sweep(_f, _u, false);
+    ite++;
+
+    // wahres Residuum r = f - a*u nur alle res_stride Schritte
+    if (ite % res_stride == 0 || ite == max_ite)
+    {
+      msr->mult(_u, res);
+
+      norm = 0.0;
+      #pragma omp parallel for reduction(+:norm) schedule(static)
+      for (int i=0; i<n; i++)
+        norm += (f[i]-r[i]) * (f[i]-r[i]);
+
+      telemetry_iteration(ite, sqrt(norm));
+
+      if (sqrt(norm) <= tol_ite)
+      {
+        converged = true;
+        break;
+      }
+    }
+  }
+
+  telemetry_finish(converged ? CONV_TOLERANCE : CONV_MAX_ITE, ite, sqrt(norm));
+  telemetry_end(PHASE_SOLVE);
+
+  if (!converged) {
+    throw runtime_error(string("MultiColorGS: Not converged in max_ite!!"));
+  } else {
+    cout << "Multicolor G-S solver converged successfully in " << ite <<
+      " iterations with tolerance " << tol_ite << " (" << gs.get_num_colors() << " colors)." << endl;
+  }
+
+  return;
+}
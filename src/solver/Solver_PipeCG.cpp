@@ -0,0 +1,293 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Loesung des LGS a*u=f mit dem pipelined CG-Verfahren
+ *  Bezeichnungen wie bei Ghysels/Vanroose:
+ *  r Residuum, u = M*r, w = A*u, m = M*w, n = A*m
+ *  s = A*p, q = M*s, z = A*q werden rekursiv mitgefuehrt.
+ *
+ *  Ersetzen des Residuums nach Cools/Vanroose: fuer die Abweichungen der
+ *  rekursiven Vektoren von ihren wahren Werten (f: r, g: s, h: u, j: w,
+ *  k: q, l: z) werden Schranken aus den lokalen Rundungsfehlern und deren
+ *  Fortpflanzung mitgefuehrt. Die Normen dazu entstehen in derselben
+ *  Reduktion wie gamma und delta, ||A|| und ||M|| werden aus den
+ *  beobachteten Verhaeltnissen ||A*v||/||v|| bzw. ||M*v||/||v|| geschaetzt.
+ *  Ueberschreitet die Schranke fuer r erstmals sqrt(eps)*||r||, werden alle
+ *  Vektoren explizit neu berechnet. replace_ite > 0 erzwingt zusaetzlich
+ *  ein Ersetzen alle replace_ite Iterationen.
+ *
+ *  Vor dem Abbruch wird das wahre Residuum geprueft. Ist es noch zu gross,
+ *  wird ersetzt und weiter iteriert.
+ *
+ */
+void Solver_PipeCG::solve(
+    Array1D<double>&              _x,                  // Loesungsvektor (o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("PipeCG: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
+  int n = _a.get_size();
+
+  int ite = 0;
+
+  Array1D<double> r(n);
+  Array1D<double> u(n);
+  Array1D<double> w(n);
+  Array1D<double> m(n);
+  Array1D<double> nn(n);
+  Array1D<double> p(n);
+  Array1D<double> s(n);
+  Array1D<double> q(n);
+  Array1D<double> z(n);
+
+  // p, s, q, z werden in der ersten Iteration mit beta = 0 verwendet
+  p.init();
+  s.init();
+  q.init();
+  z.init();
+
+  double*       x  = _x.get_dataptr();
+  double const* f  = _f.get_dataptr();
+  double*       rp = r.get_dataptr();
+  double*       up = u.get_dataptr();
+  double*       wp = w.get_dataptr();
+  double*       mp = m.get_dataptr();
+  double*       np = nn.get_dataptr();
+  double*       pp = p.get_dataptr();
+  double*       sp = s.get_dataptr();
+  double*       qp = q.get_dataptr();
+  double*       zp = z.get_dataptr();
+
+  const double eps = 1.1e-16;                          // Maschinengenauigkeit
+  const double tau = sqrt(eps);                        // Schwelle fuer das Ersetzen
+
+  double norm_a = 0.0;                                 // Schaetzung ||A||
+  double norm_m = 0.0;                                 // Schaetzung ||M||
+
+  double norm_f = 0.0;
+  for (int i=0; i<n; i++)
+    norm_f += f[i]*f[i];
+  norm_f = sqrt(norm_f);
+
+  double gamma = 0.0;
+  double delta = 0.0;
+  double nx = 0.0, nr = 0.0, nu = 0.0, nw = 0.0;       // Normen der aktuellen Vektoren
+  double np_ = 0.0, ns = 0.0, nq = 0.0, nz = 0.0;
+
+  // Schranken der Abweichungen von den wahren Werten
+  double e_f = 0.0, e_g = 0.0, e_h = 0.0, e_j = 0.0, e_k = 0.0, e_l = 0.0;
+
+  // Start bzw. Ersetzen: r = f - A*x, u = M*r, w = A*u, s = A*p, q = M*s, z = A*q
+  auto replace = [&]()
+  {
+    _a.mult(_x, w);
+    for (int i=0; i<n; i++)
+      rp[i] = f[i] - wp[i];
+    precond->apply(r, u);
+    _a.mult(u, w);
+    if (ite > 0)
+    {
+      _a.mult(p, s);
+      precond->apply(s, q);
+      _a.mult(q, z);
+    }
+
+    gamma = 0.0;
+    delta = 0.0;
+    double sx = 0.0, sr = 0.0, su = 0.0, sw = 0.0, spp = 0.0, ss = 0.0, sq = 0.0, sz = 0.0;
+    #pragma omp parallel for reduction(+:gamma,delta,sx,sr,su,sw,spp,ss,sq,sz) schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      gamma += rp[i]*up[i];
+      delta += wp[i]*up[i];
+      sx  += x[i]*x[i];
+      sr  += rp[i]*rp[i];
+      su  += up[i]*up[i];
+      sw  += wp[i]*wp[i];
+      spp += pp[i]*pp[i];
+      ss  += sp[i]*sp[i];
+      sq  += qp[i]*qp[i];
+      sz  += zp[i]*zp[i];
+    }
+    nx = sqrt(sx);  nr = sqrt(sr);  nu = sqrt(su);  nw = sqrt(sw);
+    np_ = sqrt(spp); ns = sqrt(ss); nq = sqrt(sq);  nz = sqrt(sz);
+
+    if (nr > 0.0) norm_m = max(norm_m, nu/nr);
+    if (nu > 0.0) norm_a = max(norm_a, nw/nu);
+    if (np_ > 0.0) norm_a = max(norm_a, ns/np_);
+    if (ns > 0.0) norm_m = max(norm_m, nq/ns);
+
+    // verbleibende Abweichungen: Rundungsfehler der expliziten Berechnung
+    e_f = eps*(norm_a*nx + norm_f);
+    e_h = eps*norm_m*nr;
+    e_j = eps*norm_a*nu;
+    e_g = eps*norm_a*np_;
+    e_k = eps*norm_m*ns;
+    e_l = eps*norm_a*nq;
+  };
+
+  replace();
+
+  double gamma_old = 0.0;
+  double alpha     = 0.0;
+  double beta      = 0.0;
+  bool   converged = false;
+  int    last_replace = 0;                             // Iteration des letzten Ersetzens
+
+  while (true)
+  {
+    // unabhaengig von der Reduktion der letzten Schleife
+    precond->apply(w, m);
+    _a.mult(m, nn);
+
+    if (ite == 0)
+    {
+      beta  = 0.0;
+      alpha = gamma / delta;
+    }
+    else
+    {
+      beta  = gamma / gamma_old;
+      alpha = gamma / (delta - beta*gamma/alpha);
+    }
+
+    gamma_old = gamma;
+    gamma     = 0.0;
+    delta     = 0.0;
+
+    double np_old = np_, ns_old = ns, nq_old = nq, nz_old = nz;
+    double nx_old = nx,  nr_old = nr, nu_old = nu, nw_old = nw;
+    double sx = 0.0, sr = 0.0, su = 0.0, sw = 0.0, spp = 0.0, ss = 0.0, sq = 0.0, sz = 0.0;
+    double sm = 0.0, sn = 0.0;
+
+    // alle Updates, beide Skalarprodukte und die Normen in einer Schleife
+    #pragma omp parallel for reduction(+:gamma,delta,sx,sr,su,sw,spp,ss,sq,sz,sm,sn) schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      sm += mp[i]*mp[i];
+      sn += np[i]*np[i];
+
+      zp[i] = np[i] + beta*zp[i];
+      qp[i] = mp[i] + beta*qp[i];
+      sp[i] = wp[i] + beta*sp[i];
+      pp[i] = up[i] + beta*pp[i];
+
+      spp += pp[i]*pp[i];
+      ss  += sp[i]*sp[i];
+      sq  += qp[i]*qp[i];
+      sz  += zp[i]*zp[i];
+
+      x[i]  += alpha*pp[i];
+      rp[i] -= alpha*sp[i];
+      up[i] -= alpha*qp[i];
+      wp[i] -= alpha*zp[i];
+
+      gamma += rp[i]*up[i];
+      delta += wp[i]*up[i];
+      sx  += x[i]*x[i];
+      sr  += rp[i]*rp[i];
+      su  += up[i]*up[i];
+      sw  += wp[i]*wp[i];
+    }
+
+    ite++;
+
+    double nm = sqrt(sm), nn_ = sqrt(sn);
+    nx = sqrt(sx);  nr = sqrt(sr);  nu = sqrt(su);  nw = sqrt(sw);
+    np_ = sqrt(spp); ns = sqrt(ss); nq = sqrt(sq);  nz = sqrt(sz);
+
+    if (nw_old > 0.0) norm_m = max(norm_m, nm/nw_old);
+    if (nm > 0.0)     norm_a = max(norm_a, nn_/nm);
+
+    // Schranken: lokale Rundungsfehler der Updates plus Fortpflanzung
+    double aa = fabs(alpha);
+    double ab = fabs(beta);
+    double d_p = eps*(nu_old + 2.0*ab*np_old);
+    double d_s = eps*(nw_old + 2.0*ab*ns_old);
+    double d_q = eps*(nm     + 2.0*ab*nq_old);
+    double d_z = eps*(nn_    + 2.0*ab*nz_old);
+
+    e_g = ab*e_g + e_j + norm_a*d_p + d_s;
+    e_k = ab*e_k + eps*norm_m*nw_old + norm_m*d_s + d_q;
+    e_l = ab*e_l + eps*norm_a*nm + norm_a*d_q + d_z;
+
+    double e_f_old = e_f;
+    e_f = e_f + aa*e_g + norm_a*eps*(nx_old + 2.0*aa*np_) + eps*(nr_old + 2.0*aa*ns);
+    e_h = e_h + aa*e_k + norm_m*eps*(nr_old + 2.0*aa*ns) + eps*(nu_old + 2.0*aa*nq);
+    e_j = e_j + aa*e_l + norm_a*eps*(nu_old + 2.0*aa*nq) + eps*(nw_old + 2.0*aa*nz);
+
+    converged = sqrt(fabs(gamma)) <= tol_ite;
+
+    bool do_replace = (e_f_old <= tau*nr_old && e_f > tau*nr)
+                   || (replace_ite > 0 && ite - last_replace >= replace_ite);
+
+    if (converged || do_replace)
+    {
+      replace();
+      last_replace = ite;
+
+
+      // Abbruch nur mit dem wahren Residuum
+      converged = converged && sqrt(fabs(gamma)) <= tol_ite;
+    }
+
+    telemetry_iteration(ite, sqrt(fabs(gamma)), alpha, beta);
+
+    if (converged || ite >= max_ite)
+      break;
+  }
+
+
+  telemetry_finish(converged ? CONV_TOLERANCE : CONV_MAX_ITE, ite, sqrt(fabs(gamma)));
+  telemetry_end(PHASE_SOLVE);
+
+  if (!converged) {
+    throw runtime_error(string("PipeCG: Not converged in max_ite!!"));
+  } else {
+    cout << "Pipelined CG solver converged successfully in " << ite <<
+      " iterations with tolerance " << tol_ite << "." << endl;
+  }
+
+  return;
+}
@@ -0,0 +1,607 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Groesse eines Arbeitsblocks anpassen, nur bei geaenderter Groesse neu allokiert
+ *
+ */
+static void set_size(
+    Array2D<double>&              _a,                  // Block (i/o)
+    int                           _n,                  // Anzahl Zeilen (i)
+    int                           _s                   // Anzahl Spalten (i)
+    )
+{
+  if (_a.get_size_1() != _n || _a.get_size_2() != _s)
+    _a.resize(_n, _s);
+
+  return;
+}
+
+
+
+
+/** Projektion g = a^T * x auf die ersten k Spalten eines Blocks a
+ *
+ */
+static void block_tdot(
+    Array2D<double> const&        _a,                  // Block, n x (mindestens k) (i)
+    int                           _k,                  // Anzahl verwendeter Spalten (i)
+    Array1D<double> const&        _x,                  // Vektor (i)
+    Array1D<double>&              _g                   // Ergebnis, Laenge k (o)
+    )
+{
+  int n = _a.get_size_1();
+  int k = _k;
+  double const* x = _x.get_dataptr();
+  double*       g = _g.get_dataptr();
+
+  for (int l=0; l<k; l++)
+    g[l] = 0.0;
+
+  #pragma omp parallel for reduction(+:g[:k]) schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double const* a_i = _a[i];
+    for (int l=0; l<k; l++)
+      g[l] += a_i[l]*x[i];
+  }
+
+  return;
+}
+
+
+
+
+/** Symmetrischer Anteil von a^T*b (k x k) fuer zwei Bloecke a, b (n x k)
+ *
+ */
+static void block_gram(
+    Array2D<double> const&        _a,                  // linker Block, n x k (i)
+    Array2D<double> const&        _b,                  // rechter Block, n x k (i)
+    Array2D<double>&              _g                   // Ergebnis, k x k (o)
+    )
+{
+  int n = _a.get_size_1();
+  int k = _a.get_size_2();
+
+  set_size(_g, k, k);
+
+  double* g = new double[k*k];
+  for (int l=0; l<k*k; l++)
+    g[l] = 0.0;
+
+  #pragma omp parallel for reduction(+:g[:k*k]) schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double const* a_i = _a[i];
+    double const* b_i = _b[i];
+    for (int l=0; l<k; l++)
+      for (int m=0; m<k; m++)
+        g[l*k+m] += a_i[l]*b_i[m];
+  }
+
+  for (int l=0; l<k; l++)
+    for (int m=0; m<k; m++)
+      _g[l][m] = 0.5*(g[l*k+m] + g[m*k+l]);
+
+  delete[] g;
+
+  return;
+}
+
+
+
+
+/** Cholesky-Zerlegung von a^T*b (k x k) fuer die Grobkorrektur
+ *  Rueckgabe false, wenn die Matrix nicht positiv definit ist.
+ *
+ */
+static bool factor_coarse(
+    Array2D<double> const&        _a,                  // Block W, n x k (i)
+    Array2D<double> const&        _b,                  // Block A*W, n x k (i)
+    Array2D<double>&              _l                   // unterer Cholesky-Faktor, k x k (o)
+    )
+{
+  int k = _a.get_size_2();
+
+  Array2D<double> g;
+  block_gram(_a, _b, g);
+
+  set_size(_l, k, k);
+
+  bool spd = true;
+  for (int j=0; j<k && spd; j++)
+  {
+    for (int i=j; i<k; i++)
+    {
+      double sum = g[i][j];
+      for (int m=0; m<j; m++)
+        sum -= _l[i][m]*_l[j][m];
+
+      if (i == j)
+      {
+        if (sum <= 0.0)
+        {
+          spd = false;
+          break;
+        }
+        _l[j][j] = sqrt(sum);
+      }
+      else
+        _l[i][j] = sum / _l[j][j];
+    }
+  }
+
+  return spd;
+}
+
+
+
+
+/** Eigenwerte und -vektoren einer kleinen symmetrischen Matrix
+ *  (zyklisches Jacobi-Verfahren). a wird dabei diagonalisiert, die
+ *  Eigenvektoren stehen in den Spalten von v.
+ *
+ */
+static void jacobi_eigen(
+    Array2D<double>&              _a,                  // symmetrische Matrix, m x m (i/o)
+    Array2D<double>&              _v                   // Eigenvektoren, m x m (o)
+    )
+{
+  int m = _a.get_size_1();
+
+  for (int i=0; i<m; i++)
+    for (int j=0; j<m; j++)
+      _v[i][j] = (i == j) ? 1.0 : 0.0;
+
+  for (int sweep=0; sweep<50; sweep++)
+  {
+    double off  = 0.0;
+    double diag = 0.0;
+    for (int i=0; i<m; i++)
+    {
+      diag += _a[i][i]*_a[i][i];
+      for (int j=i+1; j<m; j++)
+        off += _a[i][j]*_a[i][j];
+    }
+    if (off <= 1e-30*diag)
+      break;
+
+    for (int p=0; p<m-1; p++)
+      for (int q=p+1; q<m; q++)
+      {
+        if (_a[p][q] == 0.0)
+          continue;
+
+        double theta = (_a[q][q] - _a[p][p]) / (2.0*_a[p][q]);
+        double t     = (theta >= 0.0 ? 1.0 : -1.0) / (fabs(theta) + sqrt(theta*theta + 1.0));
+        double c     = 1.0 / sqrt(t*t + 1.0);
+        double s     = t*c;
+
+        for (int k=0; k<m; k++)
+        {
+          double a_kp = _a[k][p];
+          double a_kq = _a[k][q];
+          _a[k][p] = c*a_kp - s*a_kq;
+          _a[k][q] = s*a_kp + c*a_kq;
+        }
+        for (int k=0; k<m; k++)
+        {
+          double a_pk = _a[p][k];
+          double a_qk = _a[q][k];
+          _a[p][k] = c*a_pk - s*a_qk;
+          _a[q][k] = s*a_pk + c*a_qk;
+        }
+        for (int k=0; k<m; k++)
+        {
+          double v_kp = _v[k][p];
+          double v_kq = _v[k][q];
+          _v[k][p] = c*v_kp - s*v_kq;
+          _v[k][q] = s*v_kp + c*v_kq;
+        }
+      }
+  }
+
+  return;
+}
+
+
+
+
+/** Vorbereitung fuer eine (neue) Matrix
+ *  Der Unterraum W bleibt erhalten, A*W und W^T*A*W werden neu berechnet.
+ *
+ */
+void Solver_RecycleCG::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  Solver_CG::factorize(_a);
+  setup_deflation();
+
+  telemetry_end(PHASE_FACTORIZE);
+
+  return;
+}
+
+
+
+
+/** A*W und die Cholesky-Zerlegung von W^T*A*W fuer die aktuelle Matrix
+ *
+ */
+void Solver_RecycleCG::setup_deflation()
+{
+  int k = w.get_size_2();
+  int n = matrix->get_size();
+
+  if (k == 0)
+    return;
+
+  if (w.get_size_1() != n)
+  {
+    reset_recycle();
+    return;
+  }
+
+  if (aw.get_size_1() != n || aw.get_size_2() != k)
+    aw.resize(n, k);
+
+  matrix->mult(w, aw);
+
+  if (!factor_coarse(w, aw, waw_chol))
+    reset_recycle();
+
+  return;
+}
+
+
+
+
+/** Loesung des kleinen Systems (W^T*A*W) * c = g
+ *
+ */
+void Solver_RecycleCG::coarse_solve(
+    Array1D<double> const&        _g,                  // rechte Seite, Laenge k (i)
+    Array1D<double>&              _c                   // Loesung, Laenge k (o)
+    ) const
+{
+  int k = waw_chol.get_size_1();
+
+  for (int i=0; i<k; i++)
+  {
+    double sum = _g[i];
+    for (int j=0; j<i; j++)
+      sum -= waw_chol[i][j]*_c[j];
+    _c[i] = sum / waw_chol[i][i];
+  }
+
+  for (int i=k-1; i>=0; i--)
+  {
+    double sum = _c[i];
+    for (int j=i+1; j<k; j++)
+      sum -= waw_chol[j][i]*_c[j];
+    _c[i] = sum / waw_chol[i][i];
+  }
+
+  return;
+}
+
+
+
+
+/** Neuer Unterraum W aus Ritz-Vektoren zu den kleinsten Eigenwerten
+ *  Z = [W, P] wird orthonormiert, aus G = Z^T*A*Z folgen die Ritz-Paare,
+ *  W = Z*Y fuer die num_recycle kleinsten Ritz-Werte. A*W ergibt sich
+ *  ohne weiteres Matrix-Vektor-Produkt aus A*Z.
+ *  Orthonormiert wird mit klassischem Gram-Schmidt in zwei Durchlaeufen
+ *  (CGS2): jeder neue Vektor wird zusammenhaengend gespeichert und mit
+ *  block_tdot gegen alle bisherigen Spalten von Z zugleich projiziert.
+ *
+ */
+void Solver_RecycleCG::update_recycle(
+    int                           _num_p               // Anzahl gueltiger Zeilen in p_store (i)
+    )
+{
+  int n  = matrix->get_size();
+  int k  = w.get_size_2();
+  int mz = k + _num_p;
+
+  if (mz == 0 || num_recycle <= 0)
+    return;
+
+  set_size(z, n, mz);
+
+  Array1D<double> x(n);
+  Array1D<double> g(mz);
+  double*       xp = x.get_dataptr();
+  double const* gp = g.get_dataptr();
+
+
+  // Orthonormierung (CGS2), abhaengige Vektoren entfallen
+  int num_kept = 0;
+
+  for (int j=0; j<mz; j++)
+  {
+    if (j < k)
+    {
+      #pragma omp parallel for schedule(static)
+      for (int i=0; i<n; i++)
+        xp[i] = w[i][j];
+    }
+    else
+    {
+      double const* p_j = p_store[j-k];
+      #pragma omp parallel for schedule(static)
+      for (int i=0; i<n; i++)
+        xp[i] = p_j[i];
+    }
+
+    double norm_0 = dot(x, x);
+
+    for (int pass=0; pass<2 && num_kept>0; pass++)
+    {
+      block_tdot(z, num_kept, x, g);
+
+      #pragma omp parallel for schedule(static)
+      for (int i=0; i<n; i++)
+      {
+        double const* z_i = z[i];
+        double sum = 0.0;
+        for (int l=0; l<num_kept; l++)
+          sum += z_i[l]*gp[l];
+        xp[i] -= sum;
+      }
+    }
+
+    double norm = dot(x, x);
+
+    if (norm <= 1e-20*norm_0 || norm == 0.0)
+      continue;
+
+    norm = 1.0 / sqrt(norm);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      z[i][num_kept] = norm*xp[i];
+
+    num_kept++;
+  }
+
+  if (num_kept == 0)
+  {
+    reset_recycle();
+    return;
+  }
+
+  if (num_kept < mz)
+  {
+    Array1D<int> cols(num_kept);
+    for (int l=0; l<num_kept; l++)
+      cols[l] = l;
+    z.keep_columns(cols.get_dataptr(), num_kept);
+    mz = num_kept;
+  }
+
+
+  // Ritz-Paare aus G = Z^T*A*Z
+  set_size(az, n, mz);
+  matrix->mult(z, az);
+
+  Array2D<double> gz;
+  Array2D<double> y(mz, mz);
+  block_gram(z, az, gz);
+
+  jacobi_eigen(gz, y);
+
+
+  // die kleinsten Ritz-Werte auswaehlen
+  int kn = min(num_recycle, mz);
+  Array1D<int> sel(mz);
+  for (int l=0; l<mz; l++)
+    sel[l] = l;
+  for (int l=0; l<kn; l++)
+    for (int m=l+1; m<mz; m++)
+      if (gz[ sel[m] ][ sel[m] ] < gz[ sel[l] ][ sel[l] ])
+      {
+        int tmp = sel[l];
+        sel[l]  = sel[m];
+        sel[m]  = tmp;
+      }
+
+  set_size(w, n, kn);
+  set_size(aw, n, kn);
+
+  #pragma omp parallel for schedule(static)
+  for (int i=0; i<n; i++)
+  {
+    double const* z_i  = z[i];
+    double const* az_i = az[i];
+    for (int l=0; l<kn; l++)
+    {
+      double sw  = 0.0;
+      double saw = 0.0;
+      for (int m=0; m<mz; m++)
+      {
+        sw  += z_i[m] *y[m][ sel[l] ];
+        saw += az_i[m]*y[m][ sel[l] ];
+      }
+      w[i][l]  = sw;
+      aw[i][l] = saw;
+    }
+  }
+
+  if (!factor_coarse(w, aw, waw_chol))
+    reset_recycle();
+
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f mit deflationiertem, vorkonditioniertem CG
+ *  Bezeichnungen wie in Solver_CG: r Residuum, h = M*r, p Suchrichtung
+ *
+ */
+void Solver_RecycleCG::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("RecycleCG: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
+  int n = _a.get_size();
+  int k = w.get_size_2();
+
+  int ite = 0;
+
+  double norm_r2, norm_r, lambda, beta;
+  Array1D<double> r(n);
+  Array1D<double> h(n);
+  Array1D<double> p(n);
+  Array1D<double> ap(n);
+  Array1D<double> g( max(k,1) );
+  Array1D<double> c( max(k,1) );
+  int num_p = 0;
+
+  if (num_store > 0)
+    set_size(p_store, num_store, n);
+
+  double*       u   = _u.get_dataptr();
+  double const* f   = _f.get_dataptr();
+  double*       rp  = r.get_dataptr();
+  double*       hp  = h.get_dataptr();
+  double*       pp  = p.get_dataptr();
+  double*       app = ap.get_dataptr();
+  double const* cp  = c.get_dataptr();
+
+  _a.mult(_u, ap);
+  for (int i=0; i<n; i++)
+    rp[i] = f[i] - app[i];
+
+  // Startwert im Unterraum korrigieren: u = u + W*c, W^T*r = 0
+  if (k > 0)
+  {
+    block_tdot(w, k, r, g);
+    coarse_solve(g, c);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      double const* w_i  = w[i];
+      double const* aw_i = aw[i];
+      for (int l=0; l<k; l++)
+      {
+        u[i]  += w_i[l] *cp[l];
+        rp[i] -= aw_i[l]*cp[l];
+      }
+    }
+  }
+
+  precond->apply(r, h);
+  norm_r2 = dot(r, h);
+  beta    = 0.0;
+  for (int i=0; i<n; i++)
+    pp[i] = 0.0;
+
+  do {
+    // p = h + beta*p - W*c  mit (W^T*A*W)*c = (A*W)^T*h
+    if (k > 0)
+    {
+      block_tdot(aw, k, h, g);
+      coarse_solve(g, c);
+    }
+
+    // die ersten num_store Suchrichtungen werden fuer update_recycle gespeichert
+    double* ps = (num_p < num_store) ? p_store[num_p++] : NULL;
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      double sum = hp[i] + beta * pp[i];
+      double const* w_i = (k > 0) ? w[i] : NULL;
+      for (int l=0; l<k; l++)
+        sum -= w_i[l]*cp[l];
+      pp[i] = sum;
+      if (ps != NULL)
+        ps[i] = sum;
+    }
+
+    _a.mult(p, ap);
+    norm_r = norm_r2;
+    lambda = norm_r / dot(p, ap);
+
+    // update
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      u[i]  += lambda * pp[i];
+      rp[i] -= lambda * app[i];
+    }
+    precond->apply(r, h);
+
+    norm_r2 = dot(r, h);
+    beta    = norm_r2 / norm_r;
+
+    ite++;
+    telemetry_iteration(ite, sqrt(norm_r2), lambda, beta);
+
+  } while (ite < max_ite && sqrt(norm_r2) > tol_ite);
+
+
+  telemetry_finish(ite == max_ite ? CONV_MAX_ITE : CONV_TOLERANCE, ite, sqrt(norm_r2));
+  telemetry_end(PHASE_SOLVE);
+
+  if (ite == max_ite) {
+    throw runtime_error(string("RecycleCG: Not converged in max_ite!!"));
+  } else {
+    cout << "Recycling CG solver converged successfully in " << ite <<
+      " iterations with tolerance " << tol_ite << " (deflation space " << k << ")." << endl;
+  }
+
+  update_recycle(num_p);
+
+  return;
+}
@@ -0,0 +1,129 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+
+
+/** Vorbereitung des inneren Loesers fuer die Matrix a
+ *
+ */
+void Solver_Refinement::factorize(
+    Matrix&                       _a                   // Matrix des LGS (i)
+    )
+{
+  telemetry_begin(PHASE_FACTORIZE);
+
+  inner->factorize(_a);
+
+  Solver::factorize(_a);
+
+  telemetry_end(PHASE_FACTORIZE);
+  return;
+}
+
+
+
+
+/** Loesung des LGS a*u=f durch Nachverbesserung
+ *  u wird als Startwert verwendet.
+ *
+ */
+void Solver_Refinement::solve(
+    Array1D<double>&              _u,                  // Loesungsvektor (i/o)
+    Array1D<double>&              _f                   // rechte Seite Vektor (i)
+    )
+{
+
+  if (!factorized)
+    throw runtime_error(string("Refinement: solve without factorize!!"));
+
+  telemetry_begin(PHASE_SOLVE);
+
+  Matrix& _a = *matrix;
+
+  int n = _a.get_size();
+
+  Array1D<double> r(n);
+  Array1D<double> d(n);
+
+  double*       u  = _u.get_dataptr();
+  double const* f  = _f.get_dataptr();
+  double*       rp = r.get_dataptr();
+  double*       dp = d.get_dataptr();
+
+  double norm;
+  int ite = 0;
+
+  while (true)
+  {
+    // Residuum in voller Genauigkeit
+    _a.mult(_u, r);
+
+    norm = 0.0;
+    #pragma omp parallel for reduction(+:norm) schedule(static)
+    for (int i=0; i<n; i++)
+    {
+      rp[i] = f[i] - rp[i];
+      norm += rp[i]*rp[i];
+    }
+
+    if (ite > 0)
+      telemetry_iteration(ite, sqrt(norm));
+
+    if (sqrt(norm) <= tol_ite || ite == max_ite)
+      break;
+
+    // Korrektur mit dem inneren Loeser
+    d.init();
+    inner->solve(d, r);
+
+    #pragma omp parallel for schedule(static)
+    for (int i=0; i<n; i++)
+      u[i] += dp[i];
+
+    ite++;
+  }
+
+  telemetry_finish(sqrt(norm) > tol_ite ? CONV_MAX_ITE : CONV_TOLERANCE, ite, sqrt(norm));
+  telemetry_end(PHASE_SOLVE);
+
+  if (sqrt(norm) > tol_ite) {
+    throw runtime_error(string("Refinement: Not converged in max_ite!!"));
+  } else {
+    cout << "Refinement solver converged successfully in " << ite <<
+      " steps with tolerance " << tol_ite << "." << endl;
+  }
+
+  return;
+}
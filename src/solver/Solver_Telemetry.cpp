@@ -0,0 +1,262 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+#include <omp.h>
+
+
+static char const* reason_name[] = { "none", "tolerance", "max_ite", "direct" };
+
+
+
+
+/** Konstruktor
+ *
+ */
+Solver_Telemetry::Solver_Telemetry(
+    int                           _capacity            // Groesse des Ringpuffers (i)
+    )
+{
+  capacity      = (_capacity < 1) ? 1 : _capacity;
+  ring          = Array1D<Telemetry_Record>(capacity);
+  num_records   = 0;
+  callback      = NULL;
+  callback_data = NULL;
+
+  for (int p=0; p<2; p++)
+  {
+    t_start[p] = 0.0;
+    depth[p]   = 0;
+  }
+
+  summary.iterations     = 0;
+  summary.res_norm       = 0.0;
+  summary.time_factorize = 0.0;
+  summary.time_solve     = 0.0;
+  summary.reason         = CONV_NONE;
+}
+
+
+
+
+/** Wanduhrzeit in Sekunden
+ *
+ */
+double Solver_Telemetry::wtime()
+{
+  return omp_get_wtime();
+}
+
+
+
+
+/** Beginn einer Phase, ein neues solve leert den Ringpuffer
+ *
+ */
+void Solver_Telemetry::begin(
+    Telemetry_Phase               _phase               // Phase (i)
+    )
+{
+  if (depth[_phase]++ > 0)
+    return;
+
+  t_start[_phase] = wtime();
+
+  if (_phase == PHASE_SOLVE)
+  {
+    num_records        = 0;
+    summary.iterations = 0;
+    summary.res_norm   = 0.0;
+    summary.reason     = CONV_NONE;
+  }
+
+  return;
+}
+
+
+
+
+/** Ende einer Phase, die Zeit wird in der Zusammenfassung gespeichert
+ *
+ */
+void Solver_Telemetry::end(
+    Telemetry_Phase               _phase               // Phase (i)
+    )
+{
+  if (depth[_phase] == 0 || --depth[_phase] > 0)
+    return;
+
+  double t = wtime() - t_start[_phase];
+
+  if (_phase == PHASE_FACTORIZE)
+    summary.time_factorize = t;
+  else
+    summary.time_solve = t;
+
+  return;
+}
+
+
+
+
+/** Meldung einer Iteration
+ *
+ */
+void Solver_Telemetry::iteration(
+    int                           _ite,                // Iteration (i)
+    double                        _res_norm,           // Norm des Residuums (i)
+    double                        _alpha,              // Schrittweite (i)
+    double                        _beta                // Koeffizient der Suchrichtung (i)
+    )
+{
+  Telemetry_Record& rec = ring[num_records % capacity];
+
+  rec.ite      = _ite;
+  rec.res_norm = _res_norm;
+  rec.alpha    = _alpha;
+  rec.beta     = _beta;
+  rec.time     = wtime() - t_start[PHASE_SOLVE];
+
+  num_records++;
+
+  if (callback != NULL)
+    callback(rec, callback_data);
+
+  return;
+}
+
+
+
+
+/** Abschluss eines solve
+ *
+ */
+void Solver_Telemetry::finish(
+    Convergence_Reason            _reason,             // Grund fuer das Ende (i)
+    int                           _ite,                // Anzahl Iterationen (i)
+    double                        _res_norm            // Norm des Residuums (i)
+    )
+{
+  summary.reason     = _reason;
+  summary.iterations = _ite;
+  summary.res_norm   = _res_norm;
+
+  return;
+}
+
+
+
+
+/** k-te gehaltene Iteration, die aelteste zuerst
+ *
+ */
+Telemetry_Record const& Solver_Telemetry::get_record(
+    int                           _k                   // Nummer, 0 <= k < get_num_records() (i)
+    ) const
+{
+  int first = (num_records > capacity) ? num_records - capacity : 0;
+  return ring[ (first + _k) % capacity ];
+}
+
+
+
+
+/** Ausgabe der Zusammenfassung (eine Zeile)
+ *
+ */
+void Solver_Telemetry::print_summary() const
+{
+  printf("Solver: %s after %d iterations, residual %.3e, factorize %.3f s, solve %.3f s\n",
+         reason_name[summary.reason], summary.iterations, summary.res_norm,
+         summary.time_factorize, summary.time_solve);
+  return;
+}
+
+
+
+
+/** Ausgabe der gehaltenen Iterationen als CSV-Datei
+ *
+ */
+void Solver_Telemetry::write_csv(
+    char const*                   _filename            // Dateiname (i)
+    ) const
+{
+  FILE* fp = fopen(_filename, "w");
+  if (fp == NULL)
+    throw runtime_error(string("Telemetry: cannot open ") + _filename + "!!");
+
+  fprintf(fp, "ite,res_norm,alpha,beta,time\n");
+  for (int k=0; k<get_num_records(); k++)
+  {
+    Telemetry_Record const& rec = get_record(k);
+    fprintf(fp, "%d,%.10e,%.10e,%.10e,%.6e\n", rec.ite, rec.res_norm, rec.alpha, rec.beta, rec.time);
+  }
+
+  fclose(fp);
+  return;
+}
+
+
+
+
+/** Ausgabe von Zusammenfassung und gehaltenen Iterationen als JSON-Datei
+ *
+ */
+void Solver_Telemetry::write_json(
+    char const*                   _filename            // Dateiname (i)
+    ) const
+{
+  FILE* fp = fopen(_filename, "w");
+  if (fp == NULL)
+    throw runtime_error(string("Telemetry: cannot open ") + _filename + "!!");
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"reason\": \"%s\",\n", reason_name[summary.reason]);
+  fprintf(fp, "  \"iterations\": %d,\n", summary.iterations);
+  fprintf(fp, "  \"res_norm\": %.10e,\n", summary.res_norm);
+  fprintf(fp, "  \"time_factorize\": %.6e,\n", summary.time_factorize);
+  fprintf(fp, "  \"time_solve\": %.6e,\n", summary.time_solve);
+  fprintf(fp, "  \"history\": [");
+  for (int k=0; k<get_num_records(); k++)
+  {
+    Telemetry_Record const& rec = get_record(k);
+    fprintf(fp, "%s\n    {\"ite\": %d, \"res_norm\": %.10e, \"alpha\": %.10e, \"beta\": %.10e, \"time\": %.6e}",
+            (k > 0) ? "," : "", rec.ite, rec.res_norm, rec.alpha, rec.beta, rec.time);
+  }
+  fprintf(fp, "\n  ]\n}\n");
+
+  fclose(fp);
+  return;
+}
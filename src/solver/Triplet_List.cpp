@@ -0,0 +1,264 @@
+/*
+NumPro: Finite Elements for Research and Teaching
+Copyright (C) 2013 Institut fuer Baustatik und Baudynamik
+                   Universitaet Stuttgart
+                   Malte von Scheven
+
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 3 of the License, or
+any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+Contact:
+Dr.-Ing. Malte von Scheven
+Institut fuer Baustatik und Baudynamik
+Universitaet Stuttgart
+Paffenwaldring 7
+70550 Stuttgart, Germany
+
+http://www.ibb.uni-stuttgart.de/
+mvs@ibb.uni-stuttgart.de
+
+*/
+
+
+
+#include "Main.h"
+#include "Solver.h"
+#include <omp.h>
+
+
+
+
+/** Konstruktor fuer eine Liste mit fester Anzahl Tripel
+ *  Die Tripel werden NICHT initialisiert, jede Position muss mit set()
+ *  gesetzt werden.
+ *
+ */
+Triplet_List::Triplet_List(
+    int                           _num_eq,            // Anzahl Zeilen/Spalten (i)
+    int                           _num                // Anzahl Tripel (i)
+    )
+{
+  num_eq = _num_eq;
+  num    = _num;
+
+  key = Array1D<unsigned long long>( max(num,1) );
+  val = Array1D<double>( max(num,1) );
+}
+
+
+
+
+/** Stabiler, paralleler LSD-Radix-Sort der Schluessel (mit Werten)
+ *  Bis zu 11 Bit pro Durchlauf, die Bits werden gleichmaessig auf die
+ *  Durchlaeufe verteilt. Jeder Thread zaehlt die Ziffern seines Abschnitts,
+ *  die Zielpositionen ergeben sich aus der Praefixsumme ueber (Ziffer,
+ *  Thread), so bleibt die Reihenfolge gleicher Schluessel erhalten. Nach
+ *  der Rueckkehr zeigen key/val auf das sortierte Ergebnis.
+ *
+ */
+void Triplet_List::radix_sort(
+    unsigned long long*&          _key,               // Schluessel (io)
+    double*&                      _val,               // Werte (io)
+    unsigned long long*&          _key_tmp,           // Hilfsspeicher Schluessel (io)
+    double*&                      _val_tmp,           // Hilfsspeicher Werte (io)
+    int                           _num,               // Anzahl Tripel (i)
+    int                           _bits               // Anzahl signifikanter Bits (i)
+    )
+{
+  int passes = (_bits + 10) / 11;
+  int width  = (passes > 0) ? (_bits + passes - 1) / passes : 0;
+  int radix  = 1 << width;
+
+  int max_threads = omp_get_max_threads();
+  Array1D<int> hist( max_threads*radix );
+  int* h = hist.get_dataptr();
+
+  for (int shift=0; shift<_bits; shift+=width)
+  {
+    unsigned long long const* k_in  = _key;
+    double const*             v_in  = _val;
+    unsigned long long*       k_out = _key_tmp;
+    double*                   v_out = _val_tmp;
+
+    #pragma omp parallel num_threads(max_threads)
+    {
+      int t  = omp_get_thread_num();
+      int nt = omp_get_num_threads();
+      int lo = (int)( (long)_num*t/nt );
+      int hi = (int)( (long)_num*(t+1)/nt );
+      int* ht = h + t*radix;
+
+      for (int d=0; d<radix; d++)
+        ht[d] = 0;
+      for (int i=lo; i<hi; i++)
+        ht[ (k_in[i] >> shift) & (radix-1) ]++;
+
+      #pragma omp barrier
+      #pragma omp single
+      {
+        int offset = 0;
+        for (int d=0; d<radix; d++)
+          for (int tt=0; tt<nt; tt++)
+          {
+            int c = h[tt*radix+d];
+            h[tt*radix+d] = offset;
+            offset += c;
+          }
+      }
+
+      for (int i=lo; i<hi; i++)
+      {
+        int p = ht[ (k_in[i] >> shift) & (radix-1) ]++;
+        k_out[p] = k_in[i];
+        v_out[p] = v_in[i];
+      }
+    }
+
+    std::swap(_key, _key_tmp);
+    std::swap(_val, _val_tmp);
+  }
+
+  return;
+}
+
+
+
+
+/** Komprimieren der Tripel ins CSR-Format
+ *  1. Radix-Sort nach (Zeile, Spalte)
+ *  2. segmentierte Reduktion: jeder Thread summiert die Segmente gleicher
+ *     Schluessel, die in seinem Abschnitt beginnen (auch ueber das Ende des
+ *     Abschnitts hinaus)
+ *  3. Zeilenanfaenge aus den Zeilenwechseln der sortierten Schluessel
+ *  Die Tripelliste wird dabei sortiert. Rueckgabe ist die Anzahl der
+ *  verschiedenen Eintraege.
+ *
+ */
+int Triplet_List::compress(
+    Array1D<int>&                 _ptr,               // Zeilenanfaenge, Laenge num_eq+1 (o)
+    Array1D<int>&                 _col,               // Spaltennummern (o)
+    Array1D<double>&              _val                // Werte (o)
+    )
+{
+  // signifikante Bits der Schluessel
+  unsigned long long max_key = (unsigned long long)num_eq*num_eq;
+  int bits = 0;
+  while (bits < 64 && (max_key >> bits) != 0)
+    bits++;
+
+  Array1D<unsigned long long> key_tmp( max(num,1) );
+  Array1D<double>             val_tmp( max(num,1) );
+
+  unsigned long long* k  = key.get_dataptr();
+  double*             v  = val.get_dataptr();
+  unsigned long long* kt = key_tmp.get_dataptr();
+  double*             vt = val_tmp.get_dataptr();
+
+  radix_sort(k, v, kt, vt, num, bits);
+
+
+  // segmentierte Reduktion
+  int max_threads = omp_get_max_threads();
+  Array1D<int> seg_start( max_threads+1 );
+  int* ss = seg_start.get_dataptr();
+
+  int num_unique = 0;
+
+  #pragma omp parallel num_threads(max_threads)
+  {
+    int t  = omp_get_thread_num();
+    int nt = omp_get_num_threads();
+    int lo = (int)( (long)num*t/nt );
+    int hi = (int)( (long)num*(t+1)/nt );
+
+    int cnt = 0;
+    for (int i=lo; i<hi; i++)
+      if (i == 0 || k[i] != k[i-1])
+        cnt++;
+    ss[t+1] = cnt;
+
+    #pragma omp barrier
+    #pragma omp single
+    {
+      ss[0] = 0;
+      for (int tt=0; tt<nt; tt++)
+        ss[tt+1] += ss[tt];
+      num_unique = ss[nt];
+
+      _ptr.resize( num_eq+1 );
+      _col.resize( max(num_unique,1) );
+      _val.resize( max(num_unique,1) );
+    }
+
+    int*    pc = _col.get_dataptr();
+    double* pv = _val.get_dataptr();
+    int     p  = ss[t];
+    int     i  = lo;
+
+    // Fortsetzung eines Segments aus dem vorherigen Abschnitt ueberspringen
+    while (i < hi && i > 0 && k[i] == k[i-1])
+      i++;
+
+    while (i < hi)
+    {
+      unsigned long long ki  = k[i];
+      double             sum = v[i];
+      for (i++; i<num && k[i] == ki; i++)
+        sum += v[i];
+
+      pc[p] = (int)(ki % num_eq);
+      pv[p] = sum;
+      kt[p] = ki / num_eq;                             // Zeile, Hilfsspeicher ist frei
+      p++;
+    }
+
+    #pragma omp barrier
+
+    // Zeilenanfaenge: Zeilen zwischen zwei Eintraegen beginnen beim zweiten
+    int* pp = _ptr.get_dataptr();
+
+    #pragma omp for schedule(static)
+    for (int q=0; q<num_unique; q++)
+    {
+      long r_prev = (q == 0) ? -1 : (long)kt[q-1];
+      for (long r=r_prev+1; r<=(long)kt[q]; r++)
+        pp[r] = q;
+    }
+
+    #pragma omp single
+    {
+      long r_last = (num_unique == 0) ? -1 : (long)kt[num_unique-1];
+      for (long r=r_last+1; r<=num_eq; r++)
+        pp[r] = num_unique;
+    }
+  }
+
+  return num_unique;
+}
+
+
+
+
+/** Erzeugt aus den Tripeln eine assemblierte Matrix im MSR-Format
+ *
+ */
+Matrix_MSR* Triplet_List::create_MSR()
+{
+  Array1D<int>    ptr;
+  Array1D<int>    col;
+  Array1D<double> value;
+
+  compress(ptr, col, value);
+
+  return new Matrix_MSR(num_eq, ptr.get_dataptr(), col.get_dataptr(), value.get_dataptr());
+}